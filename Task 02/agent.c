@@ -0,0 +1,401 @@
+/* PURPOSE: Built-in agents (automated players) of the Tank Game. An agent
+ * only sees the observations of the core, it keeps its own state per match.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Local Includes */
+#include "agent.h"
+#include "util.h"
+#include "trace.h"
+#include "rng.h"
+#include "macros.h"
+
+/* Object Definitions */
+typedef struct SniperState
+{
+	Rng rng;
+	int nLooks;				/* turns since the last move, a full look around is 3 */
+	char moveKey;			/* key of the move under way (turned, not moved yet), 0 if none */
+	int isCautious;			/* never moves into a line of fire */
+} SniperState;
+
+/* Facings clockwise, with their move keys */
+static const char acFacings[4] = {DIR_UP, DIR_RIGHT, DIR_DOWN, DIR_LEFT};
+static const char acFacingKeys[4] = {KEY_UP, KEY_RIGHT, KEY_DOWN, KEY_LEFT};
+static const char acActions[AGENT_ACTIONS] = {KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT, KEY_SHOOT};
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Index of the facing in the clockwise order.
+ *
+ * @param direction facing (DIR_...).
+ * @return int index of the facing.
+ */
+static int facingIndex(char direction)
+{
+	int i, facingIdx = 0;
+
+	for (i = 1; i < 4; i++)
+	{
+		if (acFacings[i] == direction)
+			facingIdx = i;
+	}
+
+	return facingIdx;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Facing of a tank marker.
+ *
+ * @param cell tank marker (MARKER_FACE_...).
+ * @return char facing (DIR_...), 0 if the cell is not a tank.
+ */
+static char tankFacing(char cell)
+{
+	char direction = 0;
+
+	switch (cell)
+	{
+		case MARKER_FACE_UP:
+			direction = DIR_UP;
+		break;
+
+		case MARKER_FACE_DOWN:
+			direction = DIR_DOWN;
+		break;
+
+		case MARKER_FACE_LEFT:
+			direction = DIR_LEFT;
+		break;
+
+		case MARKER_FACE_RIGHT:
+			direction = DIR_RIGHT;
+		break;
+
+		default:
+			/* not a tank */
+		break;
+	}
+
+	return direction;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Follow a shot from a cell, reflected on the mirrors, to the first
+ * cell it would hit.
+ *
+ * @param pMapInfo map object.
+ * @param pStart start cell and direction of the shot.
+ * @param pTransparent cell read as empty (a tank about to leave it), NULL if none.
+ * @param pHit export variable for the cell hit and the direction the shot comes in.
+ * @return char the cell hit, MARKER_EMPTY if the shot loops forever.
+ */
+static char traceAhead(const MapInfo* pMapInfo, const GameObj* pStart,
+							const GameObj* pTransparent, GameObj* pHit)
+{
+	GameObj cur = *pStart;
+	char cell;
+	int isLoop;
+
+	do
+	{
+		cur.row += (cur.direction == DIR_DOWN) - (cur.direction == DIR_UP);
+		cur.col += (cur.direction == DIR_RIGHT) - (cur.direction == DIR_LEFT);
+
+		if (pTransparent && cur.row == pTransparent->row && cur.col == pTransparent->col)
+			cell = MARKER_EMPTY;
+		else
+			cell = getCell(pMapInfo, cur.row, cur.col);
+
+		if (cell == MARKER_FACE_BMIRROR || cell == MARKER_FACE_FMIRROR)
+			cur.direction = reflectDirection(cell, cur.direction);
+
+		isLoop = (cur.row == pStart->row && cur.col == pStart->col &&
+					cur.direction == pStart->direction);
+	} while (!isLoop && (cell == MARKER_EMPTY || cell == MARKER_FACE_BMIRROR ||
+							cell == MARKER_FACE_FMIRROR));
+
+	*pHit = cur;
+
+	return isLoop ? MARKER_EMPTY : cell;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Whether the player's shot would destroy an enemy.
+ *
+ * @param pObservation observation of the turn.
+ * @return int TRUE if the shot hits an enemy (not the player on the way back).
+ */
+static int isTargetAhead(const TankObservation* pObservation)
+{
+	GameObj hit;
+	char cell = traceAhead(pObservation->pMapInfo, &(pObservation->player), NULL, &hit);
+
+	return tankFacing(cell) != 0 &&
+			!(hit.row == pObservation->player.row && hit.col == pObservation->player.col);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Whether an enemy could shoot a cell, assuming the enemies bank their
+ * shots off the mirrors (a cautious guess, the agent does not know).
+ *
+ * @param pObservation observation of the turn.
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ * @return int TRUE if an enemy faces the cell with a clear (reflected) line.
+ */
+static int isInLineOfFire(const TankObservation* pObservation, int row, int col)
+{
+	GameObj cell, hit;
+	int i, isThreat = FALSE;
+	char hitCell;
+
+	for (i = 0; !isThreat && i < 4; i++)
+	{
+		updateObj(&cell, row, col, acFacings[i]);
+		hitCell = traceAhead(pObservation->pMapInfo, &cell, &(pObservation->player), &hit);
+
+		/* The enemy faces back along the shot that reached it */
+		isThreat = (tankFacing(hitCell) == acFacings[(facingIndex(hit.direction) + 2) % 4]);
+	}
+
+	return isThreat;
+}
+
+/**************************************************************************************************/
+/* Random Agent															    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Random agent: its state is its random stream.
+ *
+ * @param pObservation first observation of the match.
+ * @param seed seed of the match.
+ * @return void* state of the agent.
+ */
+static void* initRandom(const TankObservation* pObservation, uint64_t seed)
+{
+	Rng* pRng = (Rng*) malloc(sizeof(Rng));
+
+	seedRng(pRng, seed, 0);
+
+	return pRng;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Random agent: any key, uniformly.
+ *
+ * @param pState state of the agent.
+ * @param pObservation observation of the turn.
+ * @return char action.
+ */
+static char actRandom(void* pState, const TankObservation* pObservation)
+{
+	return acActions[rangeRng((Rng*) pState, 0, AGENT_ACTIONS - 1)];
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Release the state of an agent. Call free().
+ *
+ * @param pState state of the agent.
+ * @param gameStatus outcome of the match.
+ */
+static void finishFree(void* pState, GameStatus gameStatus)
+{
+	free(pState);
+}
+
+/**************************************************************************************************/
+/* Sniper Agents														    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Sniper agent state.
+ *
+ * @param seed seed of the match.
+ * @param isCautious never moves into a line of fire.
+ * @return SniperState* state of the agent.
+ */
+static SniperState* createSniperState(uint64_t seed, int isCautious)
+{
+	SniperState* pSniper = (SniperState*) malloc(sizeof(SniperState));
+
+	seedRng(&(pSniper->rng), seed, 0);
+	pSniper->nLooks = 0;
+	pSniper->moveKey = 0;
+	pSniper->isCautious = isCautious;
+
+	return pSniper;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Sniper agent: moves anywhere.
+ *
+ * @param pObservation first observation of the match.
+ * @param seed seed of the match.
+ * @return void* state of the agent.
+ */
+static void* initSniper(const TankObservation* pObservation, uint64_t seed)
+{
+	return createSniperState(seed, FALSE);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Lookout agent: a sniper that never moves into a line of fire.
+ *
+ * @param pObservation first observation of the match.
+ * @param seed seed of the match.
+ * @return void* state of the agent.
+ */
+static void* initLookout(const TankObservation* pObservation, uint64_t seed)
+{
+	return createSniperState(seed, TRUE);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Pick the move key of a random neighbour cell to go to (a safe one for
+ * the cautious sniper).
+ *
+ * @param pSniper sniper state.
+ * @param pObservation observation of the turn.
+ * @return char move key, 0 if there is no cell to go to.
+ */
+static char pickMove(SniperState* pSniper, const TankObservation* pObservation)
+{
+	char acMoves[4];
+	int i, row, col, nMoves = 0;
+
+	for (i = 0; i < 4; i++)
+	{
+		row = pObservation->player.row + (acFacings[i] == DIR_DOWN) - (acFacings[i] == DIR_UP);
+		col = pObservation->player.col + (acFacings[i] == DIR_RIGHT) - (acFacings[i] == DIR_LEFT);
+
+		if (getCell(pObservation->pMapInfo, row, col) == MARKER_EMPTY &&
+				!(pSniper->isCautious && isInLineOfFire(pObservation, row, col)))
+			acMoves[nMoves++] = acFacingKeys[i];
+	}
+
+	return (nMoves > 0) ? acMoves[rangeRng(&(pSniper->rng), 0, nMoves - 1)] : 0;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Sniper agent, with no target ahead: look around clockwise and, once
+ * around, move to a random neighbour cell.
+ *
+ * @param pSniper sniper state.
+ * @param pObservation observation of the turn.
+ * @return char move key.
+ */
+static char searchAction(SniperState* pSniper, const TankObservation* pObservation)
+{
+	int facingIdx = facingIndex(pObservation->player.direction);
+	char action = acFacingKeys[(facingIdx + 1) % 4];
+
+	if (pSniper->moveKey)
+	{
+		/* Turned last turn, now move */
+		action = pSniper->moveKey;
+		pSniper->moveKey = 0;
+	}
+	else if (pSniper->nLooks < 3)
+		pSniper->nLooks++;
+	else
+	{
+		pSniper->nLooks = 0;
+		pSniper->moveKey = pickMove(pSniper, pObservation);
+
+		/* A key of another facing turns first, the move comes on the next turn */
+		if (pSniper->moveKey)
+			action = pSniper->moveKey;
+		if (pSniper->moveKey == acFacingKeys[facingIdx])
+			pSniper->moveKey = 0;
+	}
+
+	return action;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Sniper agent: shoot whenever the shot (reflected on the mirrors)
+ * destroys an enemy, otherwise search.
+ *
+ * @param pState state of the agent.
+ * @param pObservation observation of the turn.
+ * @return char action.
+ */
+static char actSniper(void* pState, const TankObservation* pObservation)
+{
+	return isTargetAhead(pObservation) ? KEY_SHOOT :
+											searchAction((SniperState*) pState, pObservation);
+}
+
+/**************************************************************************************************/
+/* Agent Registry Methods												    	      		  */
+/**************************************************************************************************/
+static const Agent aAgents[] =
+{
+	{"random", &initRandom, &actRandom, &finishFree},
+	{"sniper", &initSniper, &actSniper, &finishFree},
+	{"lookout", &initLookout, &actSniper, &finishFree}
+};
+
+/**************************************************************************************************/
+/**
+ * @brief Number of built-in agents.
+ *
+ * @return int number of agents.
+ */
+int countAgents(void)
+{
+	return (int) (sizeof(aAgents) / sizeof(Agent));
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Built-in agent by index.
+ *
+ * @param agentIdx index of the agent (0 to countAgents() - 1).
+ * @return const Agent* agent.
+ */
+const Agent* getAgent(int agentIdx)
+{
+	return &(aAgents[agentIdx]);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Built-in agent by name.
+ *
+ * @param zName name of the agent.
+ * @return const Agent* agent, NULL if there is no agent of that name.
+ */
+const Agent* findAgent(const char* zName)
+{
+	const Agent* pAgent = NULL;
+	int i;
+
+	for (i = 0; i < countAgents(); i++)
+	{
+		if (strcmp(aAgents[i].zName, zName) == 0)
+			pAgent = &(aAgents[i]);
+	}
+
+	return pAgent;
+}
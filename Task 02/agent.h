@@ -0,0 +1,26 @@
+#ifndef AGENT_H
+#define AGENT_H
+
+#include <stdint.h>
+#include "tankcore.h"
+
+/* Agent callbacks: a match is one init, one act per turn and one finish */
+typedef void* (*AgentInit)(const TankObservation* pObservation, uint64_t seed);
+typedef char (*AgentAct)(void* pState, const TankObservation* pObservation);
+typedef void (*AgentFinish)(void* pState, GameStatus gameStatus);
+
+/* Object Definitions */
+typedef struct Agent
+{
+	const char* zName;
+	AgentInit init;			/* state of the agent for a match (malloc()), from the first observation */
+	AgentAct act;			/* move key (w/a/s/d) or KEY_SHOOT, any other key waits */
+	AgentFinish finish;		/* the match is over (won, lost or stopped), release the state */
+} Agent;
+
+/* Agent Registry Methods */
+int countAgents(void);
+const Agent* getAgent(int agentIdx);
+const Agent* findAgent(const char* zName);
+
+#endif
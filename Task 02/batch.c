@@ -0,0 +1,512 @@
+/* PURPOSE: Batch runner: plays the (level, move script) pairs of a manifest
+ * headlessly on a work-stealing thread pool and writes a results table.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+#define _DEFAULT_SOURCE
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+/* Local Includes */
+#include "tankcore.h"
+#include "util.h"
+#include "toolutil.h"
+#include "macros.h"
+
+/* Object Definitions */
+typedef struct BatchJob
+{
+	char* zLevel;			/* level file (config file of the game) */
+	char* zScript;			/* move script (the keys of the game, as in script mode) */
+	int jobIdx;				/* line order in the manifest */
+	int isLoaded;			/* the level and the script could be read */
+	GameStatus gameStatus;
+	int nTurns;
+	int nShots;
+	int nFrames;
+	double timeMs;
+} BatchJob;
+
+typedef struct JobDeque
+{
+	int lo;					/* jobs [lo, hi) of the sorted jobs, the owner takes from lo */
+	int hi;					/* thieves take from hi */
+	pthread_mutex_t lock;
+} JobDeque;
+
+typedef struct BatchRunner
+{
+	BatchJob* aJobs;
+	BatchJob** apSorted;	/* jobs sharing a level are next to each other */
+	int nJobs;
+	JobDeque* aDeques;		/* one per worker */
+	int nWorkers;
+	GameOptions options;
+} BatchRunner;
+
+typedef struct BatchWorker
+{
+	BatchRunner* pRunner;
+	int workerIdx;
+	const char* azLevels[BATCH_LEVEL_CACHE];	/* levels loaded by the worker */
+	TankCore* apCores[BATCH_LEVEL_CACHE];
+	int nextSlot;
+} BatchWorker;
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Copy of a string (malloc()).
+ *
+ * @param zStr string.
+ * @return char* the copy.
+ */
+static char* copyString(const char* zStr)
+{
+	char* zCopy = (char*) malloc(strlen(zStr) + 1);
+
+	strcpy(zCopy, zStr);
+	return zCopy;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Read the whole move script (malloc()).
+ *
+ * @param zFileName script file name.
+ * @return char* the keys, NULL if the file cannot be read.
+ */
+static char* readScript(const char* zFileName)
+{
+	char* zKeys = NULL;
+	long size;
+	FILE* pFile = fopen(zFileName, "r");
+
+	if (pFile)
+	{
+		fseek(pFile, 0, SEEK_END);
+		size = ftell(pFile);
+		fseek(pFile, 0, SEEK_SET);
+
+		zKeys = (char*) malloc(size + 1);
+		zKeys[fread(zKeys, 1, size, pFile)] = '\0';
+		fclose(pFile);
+	}
+
+	return zKeys;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Order of the jobs: by level, then by manifest line. Used in qsort().
+ *
+ * @param pA job pointer.
+ * @param pB job pointer.
+ * @return int comparison result.
+ */
+static int compareJobs(const void* pA, const void* pB)
+{
+	const BatchJob* pJobA = *(const BatchJob* const*) pA;
+	const BatchJob* pJobB = *(const BatchJob* const*) pB;
+	int order = strcmp(pJobA->zLevel, pJobB->zLevel);
+
+	return (order != 0) ? order : pJobA->jobIdx - pJobB->jobIdx;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Outcome of the job, as written in the results table.
+ *
+ * @param pJob job object.
+ * @return const char* outcome.
+ */
+static const char* outcomeName(const BatchJob* pJob)
+{
+	const char* zOutcome = "unfinished";
+
+	if (!pJob->isLoaded)
+		zOutcome = "invalid";
+	else if (pJob->gameStatus == ENEMY_HIT)
+		zOutcome = "won";
+	else if (pJob->gameStatus == PLAYER_HIT)
+		zOutcome = "lost";
+
+	return zOutcome;
+}
+
+/**************************************************************************************************/
+/* Manifest Methods														    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Read the manifest: one "<level file> <move script file>" per line,
+ * blank lines and lines starting with '#' are skipped.
+ *
+ * @param zFileName manifest file name.
+ * @param pRunner export variable for the jobs.
+ * @return int success status.
+ */
+static int readManifest(const char* zFileName, BatchRunner* pRunner)
+{
+	char zLine[TOOL_MAX_LINE];
+	char *zLevel, *zScript;
+	int capacity = 16;
+	FILE* pFile = fopen(zFileName, "r");
+
+	pRunner->nJobs = 0;
+	pRunner->aJobs = (BatchJob*) malloc(sizeof(BatchJob) * capacity);
+
+	while (pFile && fgets(zLine, TOOL_MAX_LINE, pFile))
+	{
+		/* The names are cut out of the line read, no width to keep in step with it */
+		zLevel = (zLine[0] != '#') ? strtok(zLine, BATCH_MANIFEST_SEPARATORS) : NULL;
+		zScript = zLevel ? strtok(NULL, BATCH_MANIFEST_SEPARATORS) : NULL;
+
+		if (zScript)
+		{
+			BatchJob* pJob;
+
+			if (pRunner->nJobs == capacity)
+			{
+				capacity *= 2;
+				pRunner->aJobs = (BatchJob*) realloc(pRunner->aJobs, sizeof(BatchJob) * capacity);
+			}
+
+			pJob = &(pRunner->aJobs[pRunner->nJobs]);
+			pJob->zLevel = copyString(zLevel);
+			pJob->zScript = copyString(zScript);
+			pJob->jobIdx = pRunner->nJobs++;
+		}
+	}
+
+	if (pFile)
+		fclose(pFile);
+	else
+		perror("Could not open the manifest");
+
+	return (pFile != NULL);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Write the results table (tab separated, manifest order).
+ *
+ * @param zFileName results file name.
+ * @param pRunner batch runner object.
+ * @return int success status.
+ */
+static int writeResults(const char* zFileName, const BatchRunner* pRunner)
+{
+	int i;
+	FILE* pFile = fopen(zFileName, "w");
+
+	if (pFile)
+	{
+		fprintf(pFile, "job\tlevel\tscript\toutcome\tturns\tshots\tframes\ttime_ms\n");
+		for (i = 0; i < pRunner->nJobs; i++)
+		{
+			const BatchJob* pJob = &(pRunner->aJobs[i]);
+			fprintf(pFile, "%d\t%s\t%s\t%s\t%d\t%d\t%d\t%.3f\n", i + 1, pJob->zLevel, 
+						pJob->zScript, outcomeName(pJob), pJob->nTurns, pJob->nShots, 
+						pJob->nFrames, pJob->timeMs);
+		}
+
+		fclose(pFile);
+	}
+	else
+		perror("Could not open the results file");
+
+	return (pFile != NULL);
+}
+
+/**************************************************************************************************/
+/* Job Methods															    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief The level ready for a new episode. A level the worker loaded before 
+ * is restarted, not read again.
+ *
+ * @param pWorker worker object.
+ * @param zLevel level file name.
+ * @return TankCore* tank core object (isLoaded is FALSE for an invalid level).
+ */
+static TankCore* loadLevel(BatchWorker* pWorker, const char* zLevel)
+{
+	int i, slot = -1;
+
+	for (i = 0; slot == -1 && i < BATCH_LEVEL_CACHE; i++)
+	{
+		if (pWorker->azLevels[i] && strcmp(pWorker->azLevels[i], zLevel) == 0)
+			slot = i;
+	}
+
+	if (slot != -1 && pWorker->apCores[slot]->isLoaded)
+	{
+		/* PERF: The parsed level is reused */
+		restartTankCore(pWorker->apCores[slot]);
+	}
+	else if (slot == -1)
+	{
+		slot = pWorker->nextSlot;
+		pWorker->nextSlot = (pWorker->nextSlot + 1) % BATCH_LEVEL_CACHE;
+
+		if (!pWorker->apCores[slot])
+			pWorker->apCores[slot] = createTankCore();
+
+		pWorker->azLevels[slot] = zLevel;
+		resetTankCore(pWorker->apCores[slot], zLevel, &(pWorker->pRunner->options));
+	}
+
+	return pWorker->apCores[slot];
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Play the move script on the level until the game is over or the 
+ * script ends. The frames are the maps the game would show: the first map, 
+ * one per key (a shot key shows its ticks instead) and one per tick.
+ *
+ * @param pWorker worker object.
+ * @param pJob job object.
+ */
+static void runJob(BatchWorker* pWorker, BatchJob* pJob)
+{
+	struct timespec start;
+	GameStatus gameStatus = INPUT_CLOSED;
+	TankCore* pCore;
+	char* zKeys;
+	int i = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	pCore = loadLevel(pWorker, pJob->zLevel);
+	zKeys = readScript(pJob->zScript);
+
+	pJob->isLoaded = pCore->isLoaded && zKeys;
+	pJob->nTurns = pJob->nShots = pJob->nFrames = 0;
+
+	while (pJob->isLoaded && gameStatus == INPUT_CLOSED && zKeys[i] != '\0')
+	{
+		char key = zKeys[i++];
+
+		/* Line ends split the batches of keys, the skip key has no shot to skip */
+		if (!isspace((unsigned char) key) && key != KEY_SKIP)
+		{
+			gameStatus = stepTankCore(pCore, key, NULL);
+			gameStatus = (gameStatus == PROGRESSING) ? INPUT_CLOSED : gameStatus;
+			pJob->nTurns++;
+			pJob->nShots += (key == KEY_SHOOT);
+			pJob->nFrames += (key != KEY_SHOOT);
+		}
+	}
+
+	if (pJob->isLoaded)
+		pJob->nFrames += 1 + pCore->nTicks;
+
+	pJob->gameStatus = gameStatus;
+	pJob->timeMs = elapsedMs(&start);
+	free(zKeys);
+}
+
+/**************************************************************************************************/
+/* Work Stealing Methods												    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Take the next job of the worker's own deque.
+ *
+ * @param pDeque deque of the worker.
+ * @param pJobIdx export variable for the job (index in the sorted jobs).
+ * @return int whether a job was taken.
+ */
+static int takeJob(JobDeque* pDeque, int* pJobIdx)
+{
+	int isTaken;
+
+	pthread_mutex_lock(&(pDeque->lock));
+	isTaken = (pDeque->lo < pDeque->hi);
+	if (isTaken)
+		*pJobIdx = pDeque->lo++;
+	pthread_mutex_unlock(&(pDeque->lock));
+
+	return isTaken;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Steal the back half of the jobs of another worker into the (empty)
+ * deque of the thief. The stolen jobs stay next to each other, so they still
+ * share their levels.
+ *
+ * @param pRunner batch runner object.
+ * @param thiefIdx index of the worker stealing.
+ * @return int whether jobs were stolen, FALSE once all the deques are empty.
+ */
+static int stealJobs(BatchRunner* pRunner, int thiefIdx)
+{
+	int i, lo = 0, hi = 0;
+
+	for (i = 1; lo == hi && i < pRunner->nWorkers; i++)
+	{
+		JobDeque* pVictim = &(pRunner->aDeques[(thiefIdx + i) % pRunner->nWorkers]);
+
+		pthread_mutex_lock(&(pVictim->lock));
+		hi = pVictim->hi;
+		lo = pVictim->hi - (pVictim->hi - pVictim->lo + 1) / 2;
+		pVictim->hi = lo;
+		pthread_mutex_unlock(&(pVictim->lock));
+	}
+
+	if (lo < hi)
+	{
+		JobDeque* pDeque = &(pRunner->aDeques[thiefIdx]);
+
+		pthread_mutex_lock(&(pDeque->lock));
+		pDeque->lo = lo;
+		pDeque->hi = hi;
+		pthread_mutex_unlock(&(pDeque->lock));
+	}
+
+	return (lo < hi);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Worker thread: run the jobs of its deque, then steal more.
+ *
+ * @param pContext worker object.
+ * @return void* NULL.
+ */
+static void* runWorker(void* pContext)
+{
+	BatchWorker* pWorker = (BatchWorker*) pContext;
+	BatchRunner* pRunner = pWorker->pRunner;
+	int jobIdx, isWorking = TRUE;
+
+	while (isWorking)
+	{
+		if (takeJob(&(pRunner->aDeques[pWorker->workerIdx]), &jobIdx))
+			runJob(pWorker, pRunner->apSorted[jobIdx]);
+		else
+			isWorking = stealJobs(pRunner, pWorker->workerIdx);
+	}
+
+	return NULL;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Run all the jobs on the workers. Each worker starts with a contiguous
+ * slice of the jobs sorted by level.
+ *
+ * @param pRunner batch runner object.
+ */
+static void runJobs(BatchRunner* pRunner)
+{
+	int i, j;
+	BatchWorker* aWorkers = (BatchWorker*) calloc(pRunner->nWorkers, sizeof(BatchWorker));
+
+	pRunner->apSorted = (BatchJob**) malloc(sizeof(BatchJob*) * (pRunner->nJobs + 1));
+	for (i = 0; i < pRunner->nJobs; i++)
+		pRunner->apSorted[i] = &(pRunner->aJobs[i]);
+	qsort(pRunner->apSorted, pRunner->nJobs, sizeof(BatchJob*), &compareJobs);
+
+	pRunner->aDeques = (JobDeque*) malloc(sizeof(JobDeque) * pRunner->nWorkers);
+	for (i = 0; i < pRunner->nWorkers; i++)
+	{
+		pRunner->aDeques[i].lo = (int) ((long) pRunner->nJobs * i / pRunner->nWorkers);
+		pRunner->aDeques[i].hi = (int) ((long) pRunner->nJobs * (i + 1) / pRunner->nWorkers);
+		pthread_mutex_init(&(pRunner->aDeques[i].lock), NULL);
+	}
+
+	for (i = 0; i < pRunner->nWorkers; i++)
+	{
+		aWorkers[i].pRunner = pRunner;
+		aWorkers[i].workerIdx = i;
+	}
+
+	runWorkers(aWorkers, sizeof(BatchWorker), pRunner->nWorkers, &runWorker);
+
+	/* The deques are destroyed once no worker can steal from them */
+	for (i = 0; i < pRunner->nWorkers; i++)
+	{
+		for (j = 0; j < BATCH_LEVEL_CACHE; j++)
+		{
+			if (aWorkers[i].apCores[j])
+				destroyTankCore(aWorkers[i].apCores[j]);
+		}
+
+		pthread_mutex_destroy(&(pRunner->aDeques[i].lock));
+	}
+
+	free(aWorkers);
+	free(pRunner->aDeques);
+	free(pRunner->apSorted);
+}
+
+/**************************************************************************************************/
+/* Main																	    	      		  */
+/**************************************************************************************************/
+int main(int argc, char *argv[])
+{
+	BatchRunner runner;
+	struct timespec start;
+	int i, exitCode = 1;
+	int nOutcomes[3] = {0, 0, 0};
+
+	memset(&runner, 0, sizeof(BatchRunner));
+	runner.nWorkers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+
+	/* Optional flags after the two file names */
+	for (i = 3; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-m") == 0)
+			runner.options.isMirrorFire = TRUE;
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+			runner.nWorkers = atoi(argv[++i]);
+		else
+			argc = 0;
+	}
+
+	if (argc < 3 || runner.nWorkers < 1)
+	{
+		printf("Usage: %s <manifest> <results file> [-m] [-t threads]\n", argv[0]);
+		printf("  manifest: one \"<level file> <move script file>\" per line\n");
+		printf("  -m  enemies bank shots off the mirrors\n");
+		printf("  -t  number of worker threads (default: one per core)\n");
+	}
+	else if (readManifest(argv[1], &runner))
+	{
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		runJobs(&runner);
+
+		for (i = 0; i < runner.nJobs; i++)
+		{
+			const char* zOutcome = outcomeName(&(runner.aJobs[i]));
+			nOutcomes[0] += (strcmp(zOutcome, "won") == 0);
+			nOutcomes[1] += (strcmp(zOutcome, "lost") == 0);
+			nOutcomes[2] += (strcmp(zOutcome, "invalid") == 0);
+		}
+
+		printf("%d jobs on %d threads in %.1f ms: %d won, %d lost, %d unfinished, %d invalid\n",
+					runner.nJobs, runner.nWorkers, elapsedMs(&start), nOutcomes[0], nOutcomes[1],
+					runner.nJobs - nOutcomes[0] - nOutcomes[1] - nOutcomes[2], nOutcomes[2]);
+
+		exitCode = writeResults(argv[2], &runner) ? 0 : 1;
+	}
+
+	for (i = 0; i < runner.nJobs; i++)
+	{
+		free(runner.aJobs[i].zLevel);
+		free(runner.aJobs[i].zScript);
+	}
+	free(runner.aJobs);
+
+	return exitCode;
+}
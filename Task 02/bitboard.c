@@ -0,0 +1,363 @@
+/* PURPOSE: Bitboard (occupancy bit sets) fast path for maps up to 64 columns.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdlib.h>
+#include <string.h>
+
+/* Local Includes */
+#include "bitboard.h"
+#include "macros.h"
+
+/**************************************************************************************************/
+/* Bit Set Helper Methods												    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Mask of the bits [lo, hi] of a word. Empty mask if lo > hi.
+ *
+ * @param lo lowest bit index (0 - 63).
+ * @param hi highest bit index (0 - 63).
+ * @return uint64_t the mask.
+ */
+static uint64_t wordMask(int lo, int hi)
+{
+	return (BITBOARD_ALL >> (BITBOARD_WORD_MASK - hi)) & (BITBOARD_ALL << lo);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Whether any bit in [lo, hi] is set in a multi-word bit set.
+ *
+ * @param aWords bit set words.
+ * @param lo lowest bit index.
+ * @param hi highest bit index.
+ * @return int TRUE if any bit is set.
+ */
+static int anyBitInRange(const uint64_t* aWords, int lo, int hi)
+{
+	int w, isAny = FALSE;
+	int loWord = lo >> BITBOARD_WORD_SHIFT, hiWord = hi >> BITBOARD_WORD_SHIFT;
+
+	for (w = loWord; !isAny && w <= hiWord; w++)
+	{
+		int wordLo = (w == loWord) ? (lo & BITBOARD_WORD_MASK) : 0;
+		int wordHi = (w == hiWord) ? (hi & BITBOARD_WORD_MASK) : BITBOARD_WORD_MASK;
+		isAny = ((aWords[w] & wordMask(wordLo, wordHi)) != 0);
+	}
+
+	return isAny;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Index of the first set bit at or after `from` (count trailing zeros).
+ *
+ * @param aWords bit set words.
+ * @param from bit index to start from.
+ * @param limit number of bits in the bit set.
+ * @return int index of the set bit, `limit` if none.
+ */
+static int nextSetBit(const uint64_t* aWords, int from, int limit)
+{
+	int found = limit;
+	int w = from >> BITBOARD_WORD_SHIFT;
+	int nWords = (limit + BITBOARD_WORD_MASK) >> BITBOARD_WORD_SHIFT;
+	uint64_t bits = (from < limit) ? (aWords[w] & (BITBOARD_ALL << (from & BITBOARD_WORD_MASK))) : 0;
+
+	while (found == limit && w < nWords)
+	{
+		if (bits)
+		{
+			found = (w << BITBOARD_WORD_SHIFT) + __builtin_ctzll(bits);
+		}
+		else
+		{
+			w++;
+			bits = (w < nWords) ? aWords[w] : 0;
+		}
+	}
+
+	return found;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Index of the last set bit at or before `from` (count leading zeros).
+ *
+ * @param aWords bit set words.
+ * @param from bit index to start from.
+ * @return int index of the set bit, -1 if none.
+ */
+static int prevSetBit(const uint64_t* aWords, int from)
+{
+	int found = -1;
+	int w = from >> BITBOARD_WORD_SHIFT;
+	uint64_t bits = (from >= 0) ?
+				(aWords[w] & (BITBOARD_ALL >> (BITBOARD_WORD_MASK - (from & BITBOARD_WORD_MASK)))) : 0;
+
+	while (found == -1 && w >= 0)
+	{
+		if (bits)
+		{
+			found = (w << BITBOARD_WORD_SHIFT) + BITBOARD_WORD_MASK - __builtin_clzll(bits);
+		}
+		else
+		{
+			w--;
+			bits = (w >= 0) ? aWords[w] : 0;
+		}
+	}
+
+	return found;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief The words of the transposed (column) bit set.
+ *
+ * @param pBitboard bitboard object.
+ * @param col column index of the map.
+ * @return uint64_t* words of the column.
+ */
+static uint64_t* columnWords(const Bitboard* pBitboard, int col)
+{
+	return pBitboard->aColBits + (size_t) col * pBitboard->colWords;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Set or clear the bit of a cell in both row and column bit sets.
+ *
+ * @param pBitboard bitboard object.
+ * @param row row index of the map.
+ * @param col column index of the map.
+ * @param isOccupied whether to set or clear the bit.
+ */
+static void writeBits(Bitboard* pBitboard, int row, int col, int isOccupied)
+{
+	uint64_t rowBit = BITBOARD_ONE << col;
+	uint64_t colBit = BITBOARD_ONE << (row & BITBOARD_WORD_MASK);
+	uint64_t* pColWord = columnWords(pBitboard, col) + (row >> BITBOARD_WORD_SHIFT);
+
+	if (isOccupied)
+	{
+		pBitboard->aRowBits[row] |= rowBit;
+		*pColWord |= colBit;
+	}
+	else
+	{
+		pBitboard->aRowBits[row] &= ~rowBit;
+		*pColWord &= ~colBit;
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Whether the cell is a border cell (always occupied on an empty map).
+ *
+ * @param pBitboard bitboard object.
+ * @param row row index of the map.
+ * @param col column index of the map.
+ * @return int TRUE if border cell.
+ */
+static int isBorderBit(const Bitboard* pBitboard, int row, int col)
+{
+	return (row == 0 || row == pBitboard->rows - 1 ||
+			col == 0 || col == pBitboard->cols - 1);
+}
+
+/**************************************************************************************************/
+/* Bitboard Managment Methods											    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Create a bitboard object for an empty map (only the border is occupied).
+ *
+ * @param rows map/canvas number of rows.
+ * @param cols map/canvas number of columns (up to BITBOARD_MAX_COLS).
+ * @return Bitboard* bitboard object.
+ */
+Bitboard* createBitboard(int rows, int cols)
+{
+	int i;
+	Bitboard* pBitboard = (Bitboard*) malloc(sizeof(Bitboard));
+
+	pBitboard->rows = rows;
+	pBitboard->cols = cols;
+	pBitboard->colWords = (rows + BITBOARD_WORD_MASK) >> BITBOARD_WORD_SHIFT;
+	pBitboard->aRowBits = (uint64_t*) calloc(rows, sizeof(uint64_t));
+	pBitboard->aColBits = (uint64_t*) calloc((size_t) cols * pBitboard->colWords, sizeof(uint64_t));
+	pBitboard->dirtyCapacity = BITBOARD_INIT_DIRTY_CAPACITY;
+	pBitboard->aiDirtyCells = (int*) malloc(sizeof(int) * pBitboard->dirtyCapacity);
+	pBitboard->aDirtyBits = (uint64_t*) calloc(rows, sizeof(uint64_t));
+	pBitboard->nDirtyCells = 0;
+	pBitboard->isAllDirty = FALSE;
+
+	/* Border: top and bottom rows, left and right columns */
+	for (i = 0; i < cols; i++)
+	{
+		writeBits(pBitboard, 0, i, TRUE);
+		writeBits(pBitboard, rows - 1, i, TRUE);
+	}
+
+	for (i = 0; i < rows; i++)
+	{
+		writeBits(pBitboard, i, 0, TRUE);
+		writeBits(pBitboard, i, cols - 1, TRUE);
+	}
+
+	return pBitboard;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy the bitboard object. Call free().
+ *
+ * @param pBitboard bitboard object.
+ */
+void destroyBitboard(Bitboard* pBitboard)
+{
+	free(pBitboard->aRowBits);
+	free(pBitboard->aColBits);
+	free(pBitboard->aiDirtyCells);
+	free(pBitboard->aDirtyBits);
+	free(pBitboard);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Reset the bitboard to an empty map (only the border is occupied).
+ *
+ * @param pBitboard bitboard object.
+ */
+void resetBitboard(Bitboard* pBitboard)
+{
+	int i, j;
+
+	/* PERF: Restore the cells changed since the last reset only */
+	for (i = 0; !pBitboard->isAllDirty && i < pBitboard->nDirtyCells; i++)
+	{
+		int row = pBitboard->aiDirtyCells[i] / pBitboard->cols;
+		int col = pBitboard->aiDirtyCells[i] % pBitboard->cols;
+		writeBits(pBitboard, row, col, isBorderBit(pBitboard, row, col));
+		pBitboard->aDirtyBits[row] = 0;
+	}
+
+	for (i = 0; pBitboard->isAllDirty && i < pBitboard->rows; i++)
+	{
+		for (j = 0; j < pBitboard->cols; j++)
+			writeBits(pBitboard, i, j, isBorderBit(pBitboard, i, j));
+
+		pBitboard->aDirtyBits[i] = 0;
+	}
+
+	pBitboard->nDirtyCells = 0;
+	pBitboard->isAllDirty = FALSE;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Mark the cell as occupied (any marker other than empty) or empty.
+ *
+ * @param pBitboard bitboard object.
+ * @param row row index of the map.
+ * @param col column index of the map.
+ * @param isOccupied whether the cell is occupied.
+ */
+void setBitboardCell(Bitboard* pBitboard, int row, int col, int isOccupied)
+{
+	uint64_t cellBit = BITBOARD_ONE << col;
+	int isChanged = (((pBitboard->aRowBits[row] & cellBit) != 0) != (isOccupied != 0));
+	int* aiGrown;
+
+	/* PERF: A cell is listed once until the next reset, the list never outgrows the map */
+	if (isChanged && !pBitboard->isAllDirty && !(pBitboard->aDirtyBits[row] & cellBit))
+	{
+		if (pBitboard->nDirtyCells == pBitboard->dirtyCapacity)
+		{
+			aiGrown = (int*) realloc(pBitboard->aiDirtyCells,
+										sizeof(int) * pBitboard->dirtyCapacity * 2);
+			if (aiGrown)
+			{
+				pBitboard->aiDirtyCells = aiGrown;
+				pBitboard->dirtyCapacity *= 2;
+			}
+			else
+				pBitboard->isAllDirty = TRUE;
+		}
+
+		if (!pBitboard->isAllDirty)
+		{
+			pBitboard->aiDirtyCells[pBitboard->nDirtyCells++] = row * pBitboard->cols + col;
+			pBitboard->aDirtyBits[row] |= cellBit;
+		}
+	}
+
+	writeBits(pBitboard, row, col, isOccupied);
+}
+
+/**************************************************************************************************/
+/* Bitboard Query Methods											    		      		  	  */
+/**************************************************************************************************/
+/**
+ * @brief Whether any cell in [st, en] of a row or a column is occupied.
+ *
+ * @param pBitboard bitboard object.
+ * @param fixed the row index (horizontal) or the column index (vertical).
+ * @param st first cell index of the range.
+ * @param en last cell index of the range.
+ * @param isVertical whether the range is on a column.
+ * @return int TRUE if occupied.
+ */
+int isBitboardRangeOccupied(const Bitboard* pBitboard, int fixed, int st, int en, int isVertical)
+{
+	int isOccupied = FALSE;
+
+	/* PERF: A row fits in a single word, a mask-and-test */
+	if (!isVertical && st <= en)
+		isOccupied = ((pBitboard->aRowBits[fixed] & wordMask(st, en)) != 0);
+	else if (isVertical && st <= en)
+		isOccupied = anyBitInRange(columnWords(pBitboard, fixed), st, en);
+
+	return isOccupied;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Find the first occupied cell starting from (row, col) inclusive,
+ * moving towards the direction.
+ *
+ * @param pBitboard bitboard object.
+ * @param row row index of the start cell.
+ * @param col column index of the start cell.
+ * @param direction direction to move.
+ * @return int row index (up/down) or column index (left/right) of the occupied
+ * cell. -1 or rows/cols if none.
+ */
+int findBitboardObstacle(const Bitboard* pBitboard, int row, int col, char direction)
+{
+	int found = -1;
+
+	switch (direction)
+	{
+		case DIR_RIGHT:
+			found = nextSetBit(&(pBitboard->aRowBits[row]), col, pBitboard->cols);
+		break;
+
+		case DIR_LEFT:
+			found = prevSetBit(&(pBitboard->aRowBits[row]), col);
+		break;
+
+		case DIR_DOWN:
+			found = nextSetBit(columnWords(pBitboard, col), row, pBitboard->rows);
+		break;
+
+		case DIR_UP:
+			found = prevSetBit(columnWords(pBitboard, col), row);
+		break;
+	}
+
+	return found;
+}
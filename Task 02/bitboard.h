@@ -0,0 +1,31 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+
+/* Object Definitions */
+typedef struct Bitboard
+{
+	uint64_t* aRowBits;		/* one word per row, bit j is set if cell (row, j) is occupied */
+	uint64_t* aColBits;		/* transposed set, colWords words per column */
+	int colWords;
+	uint64_t* aDirtyBits;	/* one word per row, bit j is set if cell (row, j) is in aiDirtyCells */
+	int* aiDirtyCells;		/* cells changed since the last reset, each cell once */
+	int nDirtyCells;
+	int dirtyCapacity;
+	int isAllDirty;			/* the dirty list could not grow, the next reset clears every row */
+	int rows;
+	int cols;
+} Bitboard;
+
+/* Bitboard Managment Methods */
+Bitboard* createBitboard(int rows, int cols);
+void destroyBitboard(Bitboard* pBitboard);
+void resetBitboard(Bitboard* pBitboard);
+void setBitboardCell(Bitboard* pBitboard, int row, int col, int isOccupied);
+
+/* Bitboard Query Methods */
+int isBitboardRangeOccupied(const Bitboard* pBitboard, int fixed, int st, int en, int isVertical);
+int findBitboardObstacle(const Bitboard* pBitboard, int row, int col, char direction);
+
+#endif
@@ -0,0 +1,190 @@
+/* PURPOSE: Bullets in flight of the Tank Game. The bullets are kept in a
+ * compact pool and shown as overlays, they are never on the collision map.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Local Includes */
+#include "bullet.h"
+#include "macros.h"
+
+/**************************************************************************************************/
+/* Bullet Pool Managment Methods										    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Create an empty bullet pool object.
+ *
+ * @return BulletPool* bullet pool object.
+ */
+BulletPool* createBulletPool(void)
+{
+	BulletPool* pPool = (BulletPool*) malloc(sizeof(BulletPool));
+
+	pPool->capacity = BULLET_INIT_CAPACITY;
+	pPool->aBullets = (Bullet*) malloc(sizeof(Bullet) * pPool->capacity);
+	pPool->nBullets = 0;
+	pPool->overlayCapacity = BULLET_INIT_CAPACITY;
+	pPool->aOverlays = (GameObj*) malloc(sizeof(GameObj) * pPool->overlayCapacity);
+	pPool->acUnder = (char*) malloc(pPool->overlayCapacity);
+	pPool->nOverlays = 0;
+	pPool->wasShown = FALSE;
+
+	return pPool;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy the bullet pool object. Call free().
+ *
+ * @param pPool bullet pool object.
+ */
+void destroyBulletPool(BulletPool* pPool)
+{
+	free(pPool->aBullets);
+	free(pPool->aOverlays);
+	free(pPool->acUnder);
+	free(pPool);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Add a bullet in flight. It is resolved on the next tick.
+ *
+ * @param pPool bullet pool object.
+ * @param pStCell start cell and direction of the bullet.
+ */
+void spawnBullet(BulletPool* pPool, const GameObj* pStCell)
+{
+	Bullet* pBullet;
+
+	if (pPool->nBullets == pPool->capacity)
+	{
+		pPool->capacity *= 2;
+		pPool->aBullets = (Bullet*) realloc(pPool->aBullets, sizeof(Bullet) * pPool->capacity);
+	}
+
+	pBullet = &(pPool->aBullets[pPool->nBullets++]);
+	pBullet->row = pStCell->row;
+	pBullet->col = pStCell->col;
+	pBullet->direction = pStCell->direction;
+	pBullet->nClear = 0;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Remove a finished bullet. The last bullet takes its place.
+ *
+ * @param pPool bullet pool object.
+ * @param bulletIdx index of the bullet.
+ */
+void removeBullet(BulletPool* pPool, int bulletIdx)
+{
+	pPool->aBullets[bulletIdx] = pPool->aBullets[--pPool->nBullets];
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Forget the empty cells known ahead of the bullets. Call when a cell
+ * becomes occupied while the bullets are in flight (e.g. the player moves).
+ *
+ * @param pPool bullet pool object.
+ */
+void resetBulletLegs(BulletPool* pPool)
+{
+	int i;
+
+	for (i = 0; i < pPool->nBullets; i++)
+		pPool->aBullets[i].nClear = 0;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Remove all the bullets and overlays (e.g. a new episode).
+ *
+ * @param pPool bullet pool object.
+ */
+void clearBullets(BulletPool* pPool)
+{
+	pPool->nBullets = 0;
+	pPool->nOverlays = 0;
+	pPool->wasShown = FALSE;
+}
+
+/**************************************************************************************************/
+/* Overlay Methods														    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Start the overlays of a new tick.
+ *
+ * @param pPool bullet pool object.
+ */
+void beginOverlays(BulletPool* pPool)
+{
+	pPool->wasShown = (pPool->nOverlays > 0);
+	pPool->nOverlays = 0;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Show a marker on the cell in the current tick.
+ *
+ * @param pPool bullet pool object.
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ * @param marker bullet or blow marker.
+ */
+void addOverlay(BulletPool* pPool, int row, int col, char marker)
+{
+	if (pPool->nOverlays == pPool->overlayCapacity)
+	{
+		pPool->overlayCapacity *= 2;
+		pPool->aOverlays = (GameObj*) realloc(pPool->aOverlays, 
+										sizeof(GameObj) * pPool->overlayCapacity);
+		pPool->acUnder = (char*) realloc(pPool->acUnder, pPool->overlayCapacity);
+	}
+
+	pPool->aOverlays[pPool->nOverlays].row = row;
+	pPool->aOverlays[pPool->nOverlays].col = col;
+	pPool->aOverlays[pPool->nOverlays].direction = marker;
+	pPool->nOverlays++;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Place the overlays on the map (for printing), remembering the cells
+ * underneath.
+ *
+ * @param pMapInfo map object.
+ * @param pPool bullet pool object.
+ */
+void placeOverlays(MapInfo* pMapInfo, BulletPool* pPool)
+{
+	int i;
+
+	for (i = 0; i < pPool->nOverlays; i++)
+	{
+		pPool->acUnder[i] = getCell(pMapInfo, pPool->aOverlays[i].row, pPool->aOverlays[i].col);
+		placeObj(pMapInfo, &(pPool->aOverlays[i]));
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Take the overlays off the map, the collision map is left as it was.
+ *
+ * @param pMapInfo map object.
+ * @param pPool bullet pool object.
+ */
+void liftOverlays(MapInfo* pMapInfo, BulletPool* pPool)
+{
+	int i;
+
+	/* Reverse order, overlays on the same cell restore the original cell */
+	for (i = pPool->nOverlays - 1; i >= 0; i--)
+		setCell(pMapInfo, pPool->aOverlays[i].row, pPool->aOverlays[i].col, pPool->acUnder[i]);
+}
@@ -0,0 +1,41 @@
+#ifndef BULLET_H
+#define BULLET_H
+
+#include "map.h"
+
+/* Object Definitions */
+typedef struct Bullet
+{
+	int row;
+	int col;
+	char direction;
+	int nClear;			/* cells ahead (from the current one) known to be empty */
+} Bullet;
+
+typedef struct BulletPool
+{
+	Bullet* aBullets;	/* bullets in flight, compact (a finished bullet is swapped out) */
+	int nBullets;
+	int capacity;
+	GameObj* aOverlays;	/* what the current tick shows: bullets ('|', '-') and blows ('X') */
+	char* acUnder;		/* cells under the overlays while they are on the map */
+	int nOverlays;
+	int overlayCapacity;
+	int wasShown;		/* whether the previous tick showed an overlay */
+} BulletPool;
+
+/* Bullet Pool Managment Methods */
+BulletPool* createBulletPool(void);
+void destroyBulletPool(BulletPool* pPool);
+void spawnBullet(BulletPool* pPool, const GameObj* pStCell);
+void removeBullet(BulletPool* pPool, int bulletIdx);
+void resetBulletLegs(BulletPool* pPool);
+void clearBullets(BulletPool* pPool);
+
+/* Overlay Methods */
+void beginOverlays(BulletPool* pPool);
+void addOverlay(BulletPool* pPool, int row, int col, char marker);
+void placeOverlays(MapInfo* pMapInfo, BulletPool* pPool);
+void liftOverlays(MapInfo* pMapInfo, BulletPool* pPool);
+
+#endif
@@ -0,0 +1,168 @@
+/* PURPOSE: Spatial hash (cell -> int) of the Tank Game. Open addressing with
+ * linear probing, keys are never removed (store a sentinel value instead).
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdlib.h>
+
+/* Local Includes */
+#include "cellhash.h"
+#include "macros.h"
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Slot of the key (linear probing). Either the slot holding the key or
+ * the free slot to insert it.
+ *
+ * @param pHash cell hash object.
+ * @param key cell key.
+ * @return int index of the slot.
+ */
+static int findSlot(const CellHash* pHash, long key)
+{
+	unsigned long mask = (unsigned long) pHash->capacity - 1;
+	unsigned long i = ((unsigned long) key * 2654435761UL) & mask;
+
+	while (pHash->alKeys[i] != -1 && pHash->alKeys[i] != key)
+		i = (i + 1) & mask;
+
+	return (int) i;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Allocate empty slots.
+ *
+ * @param pHash cell hash object.
+ * @param capacity number of slots (power of 2).
+ */
+static void allocSlots(CellHash* pHash, int capacity)
+{
+	int i;
+
+	pHash->capacity = capacity;
+	pHash->nKeys = 0;
+	pHash->alKeys = (long*) malloc(sizeof(long) * capacity);
+	pHash->aiValues = (int*) malloc(sizeof(int) * capacity);
+
+	for (i = 0; i < capacity; i++)
+		pHash->alKeys[i] = -1;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Double the slots and re-insert the keys.
+ *
+ * @param pHash cell hash object.
+ */
+static void growSlots(CellHash* pHash)
+{
+	int i, oldCapacity = pHash->capacity;
+	long* alOldKeys = pHash->alKeys;
+	int* aiOldValues = pHash->aiValues;
+
+	allocSlots(pHash, oldCapacity * 2);
+
+	for (i = 0; i < oldCapacity; i++)
+	{
+		if (alOldKeys[i] != -1)
+			insertCellHash(pHash, alOldKeys[i], aiOldValues[i]);
+	}
+
+	free(alOldKeys);
+	free(aiOldValues);
+}
+
+/**************************************************************************************************/
+/* Cell Hash Managment Methods											    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Create an empty cell hash object.
+ *
+ * @param capacity initial number of slots (power of 2).
+ * @return CellHash* cell hash object.
+ */
+CellHash* createCellHash(int capacity)
+{
+	CellHash* pHash = (CellHash*) malloc(sizeof(CellHash));
+	allocSlots(pHash, capacity);
+
+	return pHash;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy the cell hash object. Call free().
+ *
+ * @param pHash cell hash object.
+ */
+void destroyCellHash(CellHash* pHash)
+{
+	free(pHash->alKeys);
+	free(pHash->aiValues);
+	free(pHash);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Remove all the keys.
+ *
+ * @param pHash cell hash object.
+ */
+void clearCellHash(CellHash* pHash)
+{
+	int i;
+
+	for (i = 0; i < pHash->capacity; i++)
+		pHash->alKeys[i] = -1;
+
+	pHash->nKeys = 0;
+}
+
+/**************************************************************************************************/
+/* Cell Hash Access Methods												    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Value of the key.
+ *
+ * @param pHash cell hash object.
+ * @param key cell key.
+ * @param notFound value to return if the key is not in the hash.
+ * @return int value of the key.
+ */
+int lookupCellHash(const CellHash* pHash, long key, int notFound)
+{
+	int slot = findSlot(pHash, key);
+
+	return (pHash->alKeys[slot] == key) ? pHash->aiValues[slot] : notFound;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Insert the key or update its value.
+ *
+ * @param pHash cell hash object.
+ * @param key cell key (0 or more).
+ * @param value value of the key.
+ */
+void insertCellHash(CellHash* pHash, long key, int value)
+{
+	int slot = findSlot(pHash, key);
+
+	if (pHash->alKeys[slot] != key)
+	{
+		pHash->alKeys[slot] = key;
+		pHash->nKeys++;
+	}
+
+	pHash->aiValues[slot] = value;
+
+	/* PERF: Keep the load factor at most 1/2, probes stay short */
+	if (pHash->nKeys * 2 > pHash->capacity)
+		growSlots(pHash);
+}
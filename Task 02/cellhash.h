@@ -0,0 +1,22 @@
+#ifndef CELLHASH_H
+#define CELLHASH_H
+
+/* Object Definitions */
+typedef struct CellHash
+{
+	long* alKeys;		/* cell keys (row * cols + col), -1 if the slot is free */
+	int* aiValues;
+	int capacity;		/* power of 2 */
+	int nKeys;
+} CellHash;
+
+/* Cell Hash Managment Methods */
+CellHash* createCellHash(int capacity);
+void destroyCellHash(CellHash* pHash);
+void clearCellHash(CellHash* pHash);
+
+/* Cell Hash Access Methods */
+int lookupCellHash(const CellHash* pHash, long key, int notFound);
+void insertCellHash(CellHash* pHash, long key, int value);
+
+#endif
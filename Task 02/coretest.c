@@ -0,0 +1,243 @@
+/* PURPOSE: Equivalence checks of the core library: the lockstep batch
+ * (tankbatch.c) is stepped against one game core per instance with the same
+ * random actions, and every outcome and player state must match. The
+ * incremental bit-planes (planes.c) must match a full encoding.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Local Includes */
+#include "tankcore.h"
+#include "tankbatch.h"
+#include "planes.h"
+#include "envinit.h"
+#include "enemy.h"
+#include "rng.h"
+#include "macros.h"
+
+/* Object Definitions */
+typedef struct CheckConfig
+{
+	GameOptions options;
+	int nSteps;				/* steps of each check, the episodes restart when over */
+	uint64_t seed;
+	int nReports;			/* mismatches printed so far */
+} CheckConfig;
+
+static const char acActions[CHECK_ACTIONS] = {KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT, KEY_SHOOT,
+																				KEY_SKIP};
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Print a mismatch, up to CHECK_MAX_REPORTS of them.
+ *
+ * @param pConfig check configuration.
+ * @param zLevel level file name.
+ * @param zCheck name of the check.
+ * @param step step of the mismatch.
+ * @param instanceIdx instance of the mismatch.
+ */
+static void reportMismatch(CheckConfig* pConfig, const char* zLevel, const char* zCheck,
+								int step, int instanceIdx)
+{
+	if (pConfig->nReports < CHECK_MAX_REPORTS)
+		printf("%s: %s mismatch at step %d, instance %d\n", zLevel, zCheck, step, instanceIdx);
+
+	pConfig->nReports++;
+}
+
+/**************************************************************************************************/
+/* Check Methods														    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Step a batch and CHECK_INSTANCES cores with the same random actions:
+ * the game status, the player and the enemies left must match after every
+ * step. An instance whose episode is over restarts on both sides.
+ *
+ * @param pConfig check configuration.
+ * @param zLevel level file name.
+ * @param apCores CHECK_INSTANCES cores.
+ * @return long number of mismatches, -1 if the level could not be loaded.
+ */
+static long checkBatch(CheckConfig* pConfig, const char* zLevel, TankCore** apCores)
+{
+	char acStepActions[CHECK_INSTANCES];
+	long nMismatches = 0;
+	int i, step, isLoaded = TRUE;
+	TankBatch* pBatch = NULL;
+	GameStatus gameStatus;
+	Rng rng;
+
+	for (i = 0; isLoaded && i < CHECK_INSTANCES; i++)
+		isLoaded = resetTankCore(apCores[i], zLevel, &(pConfig->options));
+
+	if (isLoaded)
+	{
+		pBatch = createTankBatch(apCores[0], CHECK_INSTANCES);
+		seedRng(&rng, pConfig->seed, 0);
+
+		for (step = 0; step < pConfig->nSteps; step++)
+		{
+			for (i = 0; i < CHECK_INSTANCES; i++)
+				acStepActions[i] = acActions[rangeRng(&rng, 0, CHECK_ACTIONS - 1)];
+
+			stepTankBatch(pBatch, acStepActions);
+
+			for (i = 0; i < CHECK_INSTANCES; i++)
+			{
+				TankCore* pCore = apCores[i];
+
+				gameStatus = stepTankCore(pCore, acStepActions[i], NULL);
+
+				if (gameStatus != pBatch->aGameStatus[i] ||
+						(gameStatus == PROGRESSING &&
+						(pCore->player.row != pBatch->aiRows[i] ||
+						pCore->player.col != pBatch->aiCols[i] ||
+						pCore->player.direction != pBatch->acDirections[i] ||
+						pCore->oRP.pEnemies->nAlive != pBatch->aiAlive[i])))
+				{
+					reportMismatch(pConfig, zLevel, "batch", step, i);
+					nMismatches++;
+				}
+
+				/* Both sides restart, a mismatch is not carried over */
+				if (gameStatus != PROGRESSING || pBatch->aGameStatus[i] != PROGRESSING)
+				{
+					restartTankCore(pCore);
+					resetBatchInstance(pBatch, i);
+				}
+			}
+		}
+
+		destroyTankBatch(pBatch);
+	}
+
+	return isLoaded ? nMismatches : -1;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Step a core with random actions and encode some of the observations
+ * twice: incrementally, and from scratch. The two buffers must be the same.
+ * The episodes restart when over, so between two encodings the enemies can be
+ * destroyed and revived any number of times.
+ *
+ * @param pConfig check configuration.
+ * @param zLevel level file name.
+ * @param pCore core with the level loaded.
+ * @return long number of mismatches.
+ */
+static long checkPlanes(CheckConfig* pConfig, const char* zLevel, TankCore* pCore)
+{
+	RefreshMapParam* pRP = &(pCore->oRP);
+	PlaneEncoder* pIncremental = createPlaneEncoder(pRP->pMapInfo, pRP->pEnemies, pRP->pBullets);
+	PlaneEncoder* pFull = createPlaneEncoder(pRP->pMapInfo, pRP->pEnemies, pRP->pBullets);
+	size_t bufferSize = sizeof(uint64_t) * PLANE_COUNT * pFull->planeWords;
+	uint64_t* aIncWords = (uint64_t*) malloc(bufferSize);
+	uint64_t* aFullWords = (uint64_t*) malloc(bufferSize);
+	long nMismatches = 0;
+	int step;
+	Rng rng;
+
+	seedRng(&rng, pConfig->seed, 1);
+
+	for (step = 0; step < pConfig->nSteps; step++)
+	{
+		if (stepTankCore(pCore, acActions[rangeRng(&rng, 0, CHECK_ACTIONS - 1)], NULL) != PROGRESSING)
+			restartTankCore(pCore);
+
+		if (rangeRng(&rng, 1, CHECK_PLANES_PERIOD) == 1)
+		{
+			encodePlanes(pIncremental, pRP, aIncWords);
+			resetPlaneEncoder(pFull);
+			encodePlanes(pFull, pRP, aFullWords);
+
+			if (memcmp(aIncWords, aFullWords, bufferSize) != 0)
+			{
+				reportMismatch(pConfig, zLevel, "planes", step, 0);
+				nMismatches++;
+
+				/* Start over from the full encoding, a mismatch is not carried over */
+				resetPlaneEncoder(pIncremental);
+			}
+		}
+	}
+
+	destroyPlaneEncoder(pIncremental);
+	destroyPlaneEncoder(pFull);
+	free(aIncWords);
+	free(aFullWords);
+
+	return nMismatches;
+}
+
+/**************************************************************************************************/
+/* Main																    	      		  	  */
+/**************************************************************************************************/
+int main(int argc, char *argv[])
+{
+	CheckConfig config;
+	TankCore* apCores[CHECK_INSTANCES];
+	long nMismatches, nTotal = 0;
+	int i, j, nLevels = 0, nInvalid = 0, isValid = TRUE;
+	int exitCode = EXIT_INIT_ERROR;
+
+	memset(&config, 0, sizeof(CheckConfig));
+	config.nSteps = CHECK_DEFAULT_STEPS;
+	config.seed = 1;
+
+	/* Flags first, the level files follow */
+	for (i = 1; isValid && i < argc && argv[i][0] == '-'; i++)
+	{
+		if (strcmp(argv[i], "-m") == 0)
+			config.options.isMirrorFire = TRUE;
+		else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			config.nSteps = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+			config.seed = strtoul(argv[++i], NULL, 10);
+		else
+			isValid = FALSE;
+	}
+
+	if (!isValid || i == argc || config.nSteps < 1)
+	{
+		printf("Usage: %s [-m] [-n steps] [-s seed] <level file>...\n", argv[0]);
+		printf("  -m  enemies bank shots off the mirrors\n");
+		printf("  -n  steps of each check (default: %d)\n", CHECK_DEFAULT_STEPS);
+		printf("  -s  seed of the random actions (default: 1)\n");
+	}
+	else
+	{
+		for (j = 0; j < CHECK_INSTANCES; j++)
+			apCores[j] = createTankCore();
+
+		for (; i < argc; i++, nLevels++)
+		{
+			nMismatches = checkBatch(&config, argv[i], apCores);
+
+			if (nMismatches < 0)
+			{
+				printf("%s: %s\n", argv[i], loadErrorMessage(apCores[0]->loadError));
+				nInvalid++;
+			}
+			else
+				nTotal += nMismatches + checkPlanes(&config, argv[i], apCores[0]);
+		}
+
+		for (j = 0; j < CHECK_INSTANCES; j++)
+			destroyTankCore(apCores[j]);
+
+		printf("%d levels (%d invalid), %ld mismatches\n", nLevels, nInvalid, nTotal);
+		exitCode = (nTotal == 0 && nInvalid == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	return exitCode;
+}
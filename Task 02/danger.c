@@ -0,0 +1,542 @@
+/* PURPOSE: Danger map analyzer: for every empty cell of a level, whether
+ * moving there draws enemy fire and which facings shoot an enemy from there.
+ * Each path of the bullets through the mirrors is traced once, then the rows
+ * are looked up by a pool of threads. The result is written as a heatmap and
+ * optionally rendered over the map.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+#define _DEFAULT_SOURCE
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Local Includes */
+#include "tankcore.h"
+#include "envinit.h"
+#include "threat.h"
+#include "enemy.h"
+#include "trace.h"
+#include "render.h"
+#include "toolutil.h"
+#include "macros.h"
+
+/* Object Definitions */
+typedef struct DangerMap
+{
+	TankCore* pCore;			/* the level, the player taken off the board */
+	int rows;
+	int cols;
+	int* aiCells;				/* DANGER_... flags of each cell, row-major */
+	int* aiPathIds;				/* path of each passage (empty cell crossed along an axis) */
+	int* aiPathPos;				/* position * 2 + 1 if going up the path means up/left */
+	long* alEnds;				/* 2 per path: obstacle cell before and after, -1 for a loop */
+	int nPaths;
+	int pathCapacity;
+	int nextRow;				/* first row of the next block to trace (atomic) */
+} DangerMap;
+
+typedef struct DangerWorker
+{
+	DangerMap* pDanger;
+	long nCells;				/* empty cells traced */
+	long nThreatened;
+	long nKills;				/* (cell, facing) shooting an enemy */
+	long nSelfHits;				/* (cell, facing) shooting the player back */
+} DangerWorker;
+
+/* Facings in flag order */
+static const char acFacings[4] = {DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT};
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Whether the direction goes up or left (down the row or column).
+ *
+ * @param direction direction.
+ * @return int TRUE for up and left.
+ */
+static int isBackward(char direction)
+{
+	return (direction == DIR_UP || direction == DIR_LEFT);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Opposite of a direction.
+ *
+ * @param direction direction.
+ * @return char opposite direction.
+ */
+static char oppositeDirection(char direction)
+{
+	char opposite = DIR_UP;
+
+	switch (direction)
+	{
+		case DIR_UP:
+			opposite = DIR_DOWN;
+		break;
+
+		case DIR_LEFT:
+			opposite = DIR_RIGHT;
+		break;
+
+		case DIR_RIGHT:
+			opposite = DIR_LEFT;
+		break;
+	}
+
+	return opposite;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Passage of a bullet through a cell: the cell and the axis of the
+ * direction.
+ *
+ * @param pDanger danger map object.
+ * @param pCell cell and direction of the bullet.
+ * @return long passage key ((row * cols + col) * 2 + 1 for left/right).
+ */
+static long passageKey(const DangerMap* pDanger, const GameObj* pCell)
+{
+	return ((long) pCell->row * pDanger->cols + pCell->col) * 2 +
+				(pCell->direction == DIR_LEFT || pCell->direction == DIR_RIGHT);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Move a bullet to the next empty cell, reflecting on the mirrors (the
+ * player's shots always do).
+ *
+ * @param pMapInfo map object, without the player.
+ * @param pCell cell and direction of the bullet, updated.
+ * @return int FALSE if the bullet stopped, pCell is the obstacle then.
+ */
+static int followPath(const MapInfo* pMapInfo, GameObj* pCell)
+{
+	char cell;
+	int isMirror;
+
+	do
+	{
+		pCell->row += (pCell->direction == DIR_DOWN) - (pCell->direction == DIR_UP);
+		pCell->col += (pCell->direction == DIR_RIGHT) - (pCell->direction == DIR_LEFT);
+		cell = getCell(pMapInfo, pCell->row, pCell->col);
+
+		isMirror = (cell == MARKER_FACE_BMIRROR || cell == MARKER_FACE_FMIRROR);
+		if (isMirror)
+			pCell->direction = reflectDirection(cell, pCell->direction);
+	} while (isMirror);
+
+	return cell == MARKER_EMPTY;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Trace the whole path of bullets through a passage, from the obstacle
+ * at one end to the obstacle at the other (or once around a loop), and number
+ * its passages.
+ *
+ * @param pDanger danger map object.
+ * @param pStCell passage to trace (cell and direction).
+ */
+static void labelPath(DangerMap* pDanger, const GameObj* pStCell)
+{
+	const MapInfo* pMapInfo = pDanger->pCore->oRP.pMapInfo;
+	long key, stKey = passageKey(pDanger, pStCell);
+	int pathId = pDanger->nPaths, pos = 0, isLoop, isOpen;
+	GameObj cell = *pStCell;
+
+	if (pDanger->nPaths == pDanger->pathCapacity)
+	{
+		pDanger->pathCapacity *= 2;
+		pDanger->alEnds = (long*) realloc(pDanger->alEnds,
+											sizeof(long) * 2 * pDanger->pathCapacity);
+	}
+	pDanger->nPaths++;
+
+	/* Back to the obstacle at the start of the path, or around the loop */
+	cell.direction = oppositeDirection(cell.direction);
+	isOpen = followPath(pMapInfo, &cell);
+	while (isOpen && passageKey(pDanger, &cell) != stKey)
+		isOpen = followPath(pMapInfo, &cell);
+
+	isLoop = isOpen;
+	if (isLoop)
+	{
+		pDanger->alEnds[pathId * 2] = -1;
+		cell = *pStCell;
+	}
+	else
+	{
+		pDanger->alEnds[pathId * 2] = (long) cell.row * pDanger->cols + cell.col;
+		cell.direction = oppositeDirection(cell.direction);
+		followPath(pMapInfo, &cell);
+	}
+
+	do
+	{
+		key = passageKey(pDanger, &cell);
+		pDanger->aiPathIds[key] = pathId;
+		pDanger->aiPathPos[key] = pos * 2 + isBackward(cell.direction);
+		pos++;
+
+		isOpen = followPath(pMapInfo, &cell);
+	} while (isOpen && !(isLoop && passageKey(pDanger, &cell) == stKey));
+
+	pDanger->alEnds[pathId * 2 + 1] = isLoop ? -1 : (long) cell.row * pDanger->cols + cell.col;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Trace every path of the level once: the memoised trace segments the
+ * cells are looked up in.
+ * PERF: Linear in the cells, a shot from any cell is then answered in O(1)
+ * instead of following its path through the mirrors.
+ *
+ * @param pDanger danger map object.
+ */
+static void labelPaths(DangerMap* pDanger)
+{
+	const MapInfo* pMapInfo = pDanger->pCore->oRP.pMapInfo;
+	long i, nPassages = (long) pDanger->rows * pDanger->cols * 2;
+	GameObj cell;
+
+	pDanger->aiPathIds = (int*) malloc(sizeof(int) * nPassages);
+	pDanger->aiPathPos = (int*) malloc(sizeof(int) * nPassages);
+	pDanger->pathCapacity = DANGER_INIT_PATH_CAPACITY;
+	pDanger->alEnds = (long*) malloc(sizeof(long) * 2 * pDanger->pathCapacity);
+	pDanger->nPaths = 0;
+
+	for (i = 0; i < nPassages; i++)
+		pDanger->aiPathIds[i] = -1;
+
+	for (i = 0; i < nPassages; i++)
+	{
+		cell.row = (int) (i / 2 / pDanger->cols);
+		cell.col = (int) (i / 2 % pDanger->cols);
+		cell.direction = (i & 1) ? DIR_RIGHT : DIR_DOWN;
+
+		if (pDanger->aiPathIds[i] == -1 && getCell(pMapInfo, cell.row, cell.col) == MARKER_EMPTY)
+			labelPath(pDanger, &cell);
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Trace an empty cell: the enemy fire on it and the shot of each
+ * facing. The shot follows the path through the cell, it comes back to the
+ * player if the path crosses the cell again ahead or is a loop.
+ *
+ * @param pWorker worker object.
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ * @return int DANGER_... flags of the cell.
+ */
+static int traceCell(DangerWorker* pWorker, int row, int col)
+{
+	const DangerMap* pDanger = pWorker->pDanger;
+	const RefreshMapParam* pRP = &(pDanger->pCore->oRP);
+	int i, pathId, pos, crossPos, isAhead, isSelfHit, flags = DANGER_EMPTY;
+	long key, hitKey;
+	GameObj shooter;
+
+	if (isThreatened(pRP->pThreat, row, col))
+	{
+		flags |= DANGER_THREAT;
+		pWorker->nThreatened++;
+	}
+
+	shooter.row = row;
+	shooter.col = col;
+
+	for (i = 0; i < 4; i++)
+	{
+		shooter.direction = acFacings[i];
+		key = passageKey(pDanger, &shooter);
+		pathId = pDanger->aiPathIds[key];
+		pos = pDanger->aiPathPos[key] >> 1;
+		crossPos = pDanger->aiPathPos[key ^ 1] >> 1;
+
+		/* The shot goes up the path if its facing matches the path numbering */
+		isAhead = (isBackward(shooter.direction) == (pDanger->aiPathPos[key] & 1));
+		hitKey = pDanger->alEnds[pathId * 2 + isAhead];
+		isSelfHit = (hitKey == -1) || (pDanger->aiPathIds[key ^ 1] == pathId &&
+										(isAhead ? crossPos > pos : crossPos < pos));
+
+		if (isSelfHit)
+		{
+			flags |= 1 << (DANGER_SELF_SHIFT + i);
+			pWorker->nSelfHits++;
+		}
+		else if (findEnemyAt(pRP->pEnemies, (int) (hitKey / pDanger->cols),
+									(int) (hitKey % pDanger->cols)) != -1)
+		{
+			flags |= 1 << (DANGER_KILL_SHIFT + i);
+			pWorker->nKills++;
+		}
+	}
+
+	pWorker->nCells++;
+
+	return flags;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Thread body: trace blocks of rows until none is left.
+ * PERF: Blocks are taken from a shared counter, the rows that take longer do
+ * not hold the other threads back.
+ *
+ * @param pArg worker object.
+ * @return void* NULL.
+ */
+static void* runWorker(void* pArg)
+{
+	DangerWorker* pWorker = (DangerWorker*) pArg;
+	DangerMap* pDanger = pWorker->pDanger;
+	const MapInfo* pMapInfo = pDanger->pCore->oRP.pMapInfo;
+	int row, col, lastRow;
+	int stRow = __atomic_fetch_add(&(pDanger->nextRow), DANGER_ROWS_PER_TASK, __ATOMIC_RELAXED);
+
+	while (stRow < pDanger->rows)
+	{
+		lastRow = (stRow + DANGER_ROWS_PER_TASK < pDanger->rows) ?
+						stRow + DANGER_ROWS_PER_TASK : pDanger->rows;
+
+		for (row = stRow; row < lastRow; row++)
+		{
+			for (col = 0; col < pDanger->cols; col++)
+			{
+				if (getCell(pMapInfo, row, col) == MARKER_EMPTY)
+					pDanger->aiCells[(long) row * pDanger->cols + col] = traceCell(pWorker, row, col);
+			}
+		}
+
+		stRow = __atomic_fetch_add(&(pDanger->nextRow), DANGER_ROWS_PER_TASK, __ATOMIC_RELAXED);
+	}
+
+	return NULL;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Trace every empty cell of the level: the paths first, then the
+ * cells by blocks of rows on the threads.
+ *
+ * @param pDanger danger map object.
+ * @param nWorkers number of threads.
+ * @param pTotal export variable for the counts over all the threads.
+ */
+static void traceLevel(DangerMap* pDanger, int nWorkers, DangerWorker* pTotal)
+{
+	DangerWorker* aWorkers = (DangerWorker*) calloc(nWorkers, sizeof(DangerWorker));
+	int i;
+
+	labelPaths(pDanger);
+
+	for (i = 0; i < nWorkers; i++)
+		aWorkers[i].pDanger = pDanger;
+
+	runWorkers(aWorkers, sizeof(DangerWorker), nWorkers, &runWorker);
+	memset(pTotal, 0, sizeof(DangerWorker));
+
+	for (i = 0; i < nWorkers; i++)
+	{
+		pTotal->nCells += aWorkers[i].nCells;
+		pTotal->nThreatened += aWorkers[i].nThreatened;
+		pTotal->nKills += aWorkers[i].nKills;
+		pTotal->nSelfHits += aWorkers[i].nSelfHits;
+	}
+
+	free(aWorkers);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Write the heatmap: the map with each empty cell replaced by
+ * DANGER_MARKER_THREAT if moving there draws fire, else by the hex digit of
+ * its shooting facings (bit i for up, down, left, right), '.' if none.
+ *
+ * @param pDanger danger map object, traced.
+ * @param pFile heatmap file.
+ */
+static void writeHeatmap(DangerMap* pDanger, FILE* pFile)
+{
+	const MapInfo* pMapInfo = pDanger->pCore->oRP.pMapInfo;
+	int row, col, flags, kills;
+	char cell;
+
+	fprintf(pFile, "%d %d\n", pDanger->rows, pDanger->cols);
+
+	for (row = 0; row < pDanger->rows; row++)
+	{
+		for (col = 0; col < pDanger->cols; col++)
+		{
+			flags = pDanger->aiCells[(long) row * pDanger->cols + col];
+			kills = (flags >> DANGER_KILL_SHIFT) & 0xF;
+			cell = getCell(pMapInfo, row, col);
+
+			if (flags & DANGER_THREAT)
+				cell = DANGER_MARKER_THREAT;
+			else if (flags & DANGER_EMPTY)
+				cell = kills ? "0123456789abcdef"[kills] : DANGER_MARKER_NONE;
+
+			fputc(cell, pFile);
+		}
+
+		fputc('\n', pFile);
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Render the danger over the map with printAndStoreMap(): the cells
+ * drawing fire and the cells shooting an enemy are marked, the player is
+ * back at the start cell.
+ *
+ * @param pDanger danger map object, traced.
+ * @param pFile overlay file.
+ */
+static void writeOverlay(DangerMap* pDanger, FILE* pFile)
+{
+	RefreshMapParam* pRP = &(pDanger->pCore->oRP);
+	FileEx fileEx;
+	int row, col, flags;
+
+	for (row = 0; row < pDanger->rows; row++)
+	{
+		for (col = 0; col < pDanger->cols; col++)
+		{
+			flags = pDanger->aiCells[(long) row * pDanger->cols + col];
+
+			if (flags & DANGER_THREAT)
+				setCell(pRP->pMapInfo, row, col, DANGER_MARKER_THREAT);
+			else if ((flags >> DANGER_KILL_SHIFT) & 0xF)
+				setCell(pRP->pMapInfo, row, col, DANGER_MARKER_KILL);
+		}
+	}
+
+	placeObj(pRP->pMapInfo, pRP->pPlayer);
+
+	fileEx.fptr = pFile;
+	fileEx.zFileName = NULL;
+	pRP->pLogFile = &fileEx;
+	pRP->isStoreMap = FALSE;
+	printAndStoreMap(pRP);
+	pRP->pLogFile = NULL;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Open a file for writing, then call the writer on it.
+ *
+ * @param zFileName file name.
+ * @param pDanger danger map object, traced.
+ * @param pWrite writer (writeHeatmap() or writeOverlay()).
+ * @return int success status.
+ */
+static int saveDanger(const char* zFileName, DangerMap* pDanger,
+						void (*pWrite)(DangerMap*, FILE*))
+{
+	FILE* pFile = fopen(zFileName, "w");
+
+	if (pFile)
+	{
+		(*pWrite)(pDanger, pFile);
+		fclose(pFile);
+	}
+	else
+		perror(zFileName);
+
+	return pFile != NULL;
+}
+
+/**************************************************************************************************/
+/* Main Entry															    		      		  */
+/**************************************************************************************************/
+int main(int argc, char *argv[])
+{
+	GameOptions options;
+	TankCore* pCore = createTankCore();
+	DangerMap danger;
+	DangerWorker total;
+	const char* zOverlayFileName = NULL;
+	struct timespec start;
+	int i, nWorkers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	int exitCode = EXIT_INIT_ERROR;
+
+	memset(&options, 0, sizeof(GameOptions));
+
+	/* Optional flags after the level and heatmap files */
+	for (i = 3; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-m") == 0)
+			options.isMirrorFire = TRUE;
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+			nWorkers = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+			zOverlayFileName = argv[++i];
+		else
+			argc = 0;
+	}
+
+	if (argc < 3 || nWorkers < 1)
+	{
+		printf("Usage: %s <level file> <heatmap file> [-m] [-t threads] [-r overlay file]\n",
+					argv[0]);
+		printf("  -m  enemies bank shots off the mirrors\n");
+		printf("  -t  number of worker threads (default: one per core)\n");
+		printf("  -r  render the danger over the map ('%c' draws fire, '%c' shoots an enemy)\n",
+					DANGER_MARKER_THREAT, DANGER_MARKER_KILL);
+	}
+	else if (resetTankCore(pCore, argv[1], &options))
+	{
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		/* Lines of fire while the player is on the board (it does not block them) */
+		refreshThreatMask(pCore->oRP.pThreat, pCore->oRP.pMapInfo, pCore->oRP.pEnemies,
+								&(pCore->player));
+		setCell(pCore->oRP.pMapInfo, pCore->player.row, pCore->player.col, MARKER_EMPTY);
+
+		danger.pCore = pCore;
+		danger.rows = pCore->oRP.pMapInfo->rows;
+		danger.cols = pCore->oRP.pMapInfo->cols;
+		danger.aiCells = (int*) calloc((long) danger.rows * danger.cols, sizeof(int));
+		danger.nextRow = 0;
+		traceLevel(&danger, nWorkers, &total);
+
+		printf("%ld empty cells, %ld draw fire, %ld (cell, facing) shoot an enemy, "
+					"%ld shoot back at the player, %d threads, %.1f ms\n",
+					total.nCells, total.nThreatened, total.nKills, total.nSelfHits,
+					nWorkers, elapsedMs(&start));
+
+		exitCode = EXIT_SUCCESS;
+		if (!saveDanger(argv[2], &danger, &writeHeatmap) ||
+				(zOverlayFileName && !saveDanger(zOverlayFileName, &danger, &writeOverlay)))
+		{
+			exitCode = EXIT_SAVE_ERROR;
+		}
+
+		free(danger.aiCells);
+		free(danger.aiPathIds);
+		free(danger.aiPathPos);
+		free(danger.alEnds);
+	}
+	else
+	{
+		fprintf(stderr, "%s: %s\n", argv[1], loadErrorMessage(pCore->loadError));
+	}
+
+	destroyTankCore(pCore);
+
+	return exitCode;
+}
@@ -0,0 +1,189 @@
+/* PURPOSE: Enemy tanks of the Tank Game, stored as a structure of arrays with
+ * a spatial hash for the occupancy.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Local Includes */
+#include "enemy.h"
+#include "macros.h"
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Double the capacity of the enemy arrays.
+ *
+ * @param pEnemies enemy set object.
+ */
+static void growEnemySet(EnemySet* pEnemies)
+{
+	pEnemies->capacity *= 2;
+	pEnemies->aiRows = (int*) realloc(pEnemies->aiRows, sizeof(int) * pEnemies->capacity);
+	pEnemies->aiCols = (int*) realloc(pEnemies->aiCols, sizeof(int) * pEnemies->capacity);
+	pEnemies->acDirections = (char*) realloc(pEnemies->acDirections, pEnemies->capacity);
+	pEnemies->aIsAlive = (char*) realloc(pEnemies->aIsAlive, pEnemies->capacity);
+}
+
+/**************************************************************************************************/
+/* Enemy Set Managment Methods											    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Create an empty enemy set object.
+ *
+ * @param cols map/canvas number of columns.
+ * @return EnemySet* enemy set object.
+ */
+EnemySet* createEnemySet(int cols)
+{
+	EnemySet* pEnemies = (EnemySet*) malloc(sizeof(EnemySet));
+
+	pEnemies->capacity = ENEMY_INIT_CAPACITY;
+	pEnemies->aiRows = (int*) malloc(sizeof(int) * pEnemies->capacity);
+	pEnemies->aiCols = (int*) malloc(sizeof(int) * pEnemies->capacity);
+	pEnemies->acDirections = (char*) malloc(pEnemies->capacity);
+	pEnemies->aIsAlive = (char*) malloc(pEnemies->capacity);
+	pEnemies->nEnemies = 0;
+	pEnemies->nAlive = 0;
+	pEnemies->generation = 0;
+	pEnemies->cols = cols;
+	pEnemies->pOccupancy = createCellHash(CELL_HASH_INIT_CAPACITY);
+
+	return pEnemies;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy the enemy set object. Call free().
+ *
+ * @param pEnemies enemy set object.
+ */
+void destroyEnemySet(EnemySet* pEnemies)
+{
+	free(pEnemies->aiRows);
+	free(pEnemies->aiCols);
+	free(pEnemies->acDirections);
+	free(pEnemies->aIsAlive);
+	destroyCellHash(pEnemies->pOccupancy);
+	free(pEnemies);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Add an enemy. Fails if another enemy is on the same cell.
+ *
+ * @param pEnemies enemy set object.
+ * @param pEnemy enemy object.
+ * @return int success status.
+ */
+int addEnemy(EnemySet* pEnemies, const GameObj* pEnemy)
+{
+	int isSuccess = (findEnemyAt(pEnemies, pEnemy->row, pEnemy->col) == -1);
+
+	if (isSuccess)
+	{
+		int i = pEnemies->nEnemies;
+
+		if (i == pEnemies->capacity)
+			growEnemySet(pEnemies);
+
+		pEnemies->aiRows[i] = pEnemy->row;
+		pEnemies->aiCols[i] = pEnemy->col;
+		pEnemies->acDirections[i] = pEnemy->direction;
+		pEnemies->aIsAlive[i] = TRUE;
+		pEnemies->nEnemies++;
+		pEnemies->nAlive++;
+		pEnemies->generation++;
+
+		insertCellHash(pEnemies->pOccupancy, 
+						(long) pEnemy->row * pEnemies->cols + pEnemy->col, i);
+	}
+
+	return isSuccess;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy an enemy (shot by a bullet). Its cell becomes empty.
+ *
+ * @param pEnemies enemy set object.
+ * @param enemyIdx index of the enemy.
+ */
+void killEnemy(EnemySet* pEnemies, int enemyIdx)
+{
+	if (pEnemies->aIsAlive[enemyIdx])
+	{
+		pEnemies->aIsAlive[enemyIdx] = FALSE;
+		pEnemies->nAlive--;
+		pEnemies->generation++;
+
+		insertCellHash(pEnemies->pOccupancy, 
+			(long) pEnemies->aiRows[enemyIdx] * pEnemies->cols + pEnemies->aiCols[enemyIdx], -1);
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Bring all the destroyed enemies back on their cells (e.g. a new 
+ * episode of the level).
+ *
+ * @param pEnemies enemy set object.
+ */
+void reviveEnemies(EnemySet* pEnemies)
+{
+	int i;
+
+	for (i = 0; i < pEnemies->nEnemies; i++)
+	{
+		if (!pEnemies->aIsAlive[i])
+		{
+			pEnemies->aIsAlive[i] = TRUE;
+			insertCellHash(pEnemies->pOccupancy, 
+							(long) pEnemies->aiRows[i] * pEnemies->cols + pEnemies->aiCols[i], i);
+		}
+	}
+
+	pEnemies->nAlive = pEnemies->nEnemies;
+	pEnemies->generation++;
+}
+
+/**************************************************************************************************/
+/* Enemy Set Query Methods												    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Get the enemy as a game object.
+ *
+ * @param pEnemies enemy set object.
+ * @param enemyIdx index of the enemy.
+ * @param pEnemy export variable for the enemy object.
+ */
+void getEnemy(const EnemySet* pEnemies, int enemyIdx, GameObj* pEnemy)
+{
+	pEnemy->row = pEnemies->aiRows[enemyIdx];
+	pEnemy->col = pEnemies->aiCols[enemyIdx];
+	pEnemy->direction = pEnemies->acDirections[enemyIdx];
+}
+
+/**************************************************************************************************/
+/**
+ * @brief The live enemy on the cell. O(1) spatial hash lookup.
+ *
+ * @param pEnemies enemy set object.
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ * @return int index of the enemy, -1 if none.
+ */
+int findEnemyAt(const EnemySet* pEnemies, int row, int col)
+{
+	int enemyIdx = -1;
+
+	if (BETWEEN(0, pEnemies->cols - 1, col) && row >= 0)
+		enemyIdx = lookupCellHash(pEnemies->pOccupancy, (long) row * pEnemies->cols + col, -1);
+
+	return enemyIdx;
+}
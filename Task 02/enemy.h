@@ -0,0 +1,33 @@
+#ifndef ENEMY_H
+#define ENEMY_H
+
+#include "map.h"
+#include "cellhash.h"
+
+/* Object Definitions */
+typedef struct EnemySet
+{
+	int* aiRows;			/* structure of arrays, one entry per enemy */
+	int* aiCols;
+	char* acDirections;
+	char* aIsAlive;
+	int nEnemies;
+	int nAlive;
+	long generation;		/* bumped whenever an enemy is added, destroyed or revived */
+	int capacity;
+	int cols;				/* map columns, for the cell keys */
+	CellHash* pOccupancy;	/* spatial hash: cell -> enemy index, -1 once destroyed */
+} EnemySet;
+
+/* Enemy Set Managment Methods */
+EnemySet* createEnemySet(int cols);
+void destroyEnemySet(EnemySet* pEnemies);
+int addEnemy(EnemySet* pEnemies, const GameObj* pEnemy);
+void killEnemy(EnemySet* pEnemies, int enemyIdx);
+void reviveEnemies(EnemySet* pEnemies);
+
+/* Enemy Set Query Methods */
+void getEnemy(const EnemySet* pEnemies, int enemyIdx, GameObj* pEnemy);
+int findEnemyAt(const EnemySet* pEnemies, int row, int col);
+
+#endif
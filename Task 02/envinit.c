@@ -13,7 +13,7 @@
 #include "macros.h"
 #include "envinit.h"
 #include "validate.h"
-#include "gameops.h"
+#include "enemy.h"
 
 /**************************************************************************************************/
 /* Mirror Linked List Related Methods													    	  */
@@ -60,14 +60,18 @@ void printNodeLog(void* pData)
 #ifdef DEBUG
 
 	/* Declarations */	
-	RefreshMapParam oRP;
+	int i, j;
 	NodeData* pNodeData = (NodeData*) pData;
 	printf("Log Data: %p\n", (void*)pNodeData);
 	
-	packRefreshParams(&oRP, pNodeData->pMapInfo, 
-						NULL, NULL, NULL,
-						NULL, NULL, NULL, FALSE);	
-	printAndStoreMap(&oRP);
+	/* The display is not linked in the core library, print the cells as they are */
+	for (i = 0 ; i < pNodeData->pMapInfo->rows ; i++)
+	{
+		for (j = 0 ; j < pNodeData->pMapInfo->cols ; j++)
+			printf("%c", getCell(pNodeData->pMapInfo, i, j));
+
+		printf("\n");
+	}
 
 #endif
 }
@@ -90,18 +94,63 @@ void cleanNodeLog(void* pData)
 	free(pNodeData);	
 }
 
+/**
+ * @brief Validate and add an extra enemy (a variable config line with a tank
+ * direction u/d/l/r). The mirrors read so far are on the map.
+ * 
+ * @param pEnemies enemy set object.
+ * @param pMapInfo map object (struct MapInfo).
+ * @param pEnemy enemy object.
+ * @param pPlayer player object.
+ * @param piLoadError export variable for the error if invalid (LOAD_...).
+ * @return int success status.
+ */
+static int addExtraEnemy(EnemySet* pEnemies, MapInfo* pMapInfo, GameObj* pEnemy, GameObj* pPlayer,
+																			int* piLoadError)
+{
+	int isSuccess = TRUE;
+
+	if (!validateObjBounds(pMapInfo, pEnemy))
+	{
+		*piLoadError = LOAD_ENEMY_BOUNDS;
+		isSuccess = FALSE;
+	}
+	else if (isObjOverlap(pEnemy, pPlayer))
+	{
+		*piLoadError = LOAD_TANK_OVERLAP;
+		isSuccess = FALSE;
+	}
+	else if (getCell(pMapInfo, pEnemy->row, pEnemy->col) != MARKER_EMPTY)
+	{
+		*piLoadError = LOAD_ENEMY_ON_MIRROR;
+		isSuccess = FALSE;
+	}
+	else if (!addEnemy(pEnemies, pEnemy))
+	{
+		*piLoadError = LOAD_ENEMY_OVERLAP;
+		isSuccess = FALSE;
+	}
+
+	return isSuccess;
+}
+
+/**************************************************************************************************/
 /**
  * @brief Read mirros from the configuration file and add them to a linked list.
+ * Lines with a tank direction (u/d/l/r) are extra enemies. The mirrors are
+ * placed on the map as they are read, so an enemy and a mirror on the same
+ * cell are rejected in either order.
  * 
  * @param configFilePtr configuration file (FILE*)
  * @param pMirrorList linked list to add mirror objects.
  * @param pMapInfo map object (struct MapInfo).
- * @param pEnemy enemy object.
+ * @param pEnemies enemy set object.
  * @param pPlayer player object.
+ * @param piLoadError export variable for the error if invalid (LOAD_...).
  * @return int success status.
  */
 static int addMirrorsToList(FILE* configFilePtr, LinkedList* pMirrorList, 
-					MapInfo* pMapInfo, GameObj* pEnemy, GameObj* pPlayer)
+					MapInfo* pMapInfo, EnemySet* pEnemies, GameObj* pPlayer, int* piLoadError)
 {	
 	/* Declarations: linked list debug prints */
 	int nodeCounter = 0;
@@ -115,15 +164,21 @@ static int addMirrorsToList(FILE* configFilePtr, LinkedList* pMirrorList,
 	do {
 		nItems = fscanf(configFilePtr, "%d %d %c ", &row, &col, &direction);
 		
-		if (nItems == 3)
+		if (nItems == 3 && validateDirection(direction))
+		{
+			GameObj enemy; updateObj(&enemy, row, col, direction);
+			isSuccess = addExtraEnemy(pEnemies, pMapInfo, &enemy, pPlayer, piLoadError);
+		}
+		else if (nItems == 3)
 		{
 			GameObj* pMirror = (GameObj*) malloc(sizeof(GameObj));
 			pMirror->row = row; pMirror->col = col; pMirror->direction = direction;
 			
-			isSuccess = validateMirror(pMirror, pMapInfo, pPlayer, pEnemy);
+			isSuccess = validateMirror(pMirror, pMapInfo, pEnemies, pPlayer, piLoadError);
 			if (isSuccess)	
 			{
 				insertLast(pMirrorList, pMirror);
+				placeObj(pMapInfo, pMirror);
 				
 				/* Debug print Mirror LinkedList */
 				nodeCounter++;		
@@ -152,56 +207,26 @@ static int addMirrorsToList(FILE* configFilePtr, LinkedList* pMirrorList,
 /**************************************************************************************************/
 
 /**
- * @brief Parse command line arguments and export the necessary variables.
- * 
- * 
- * @param argc command line args count.
- * @param argv command line args strings.
- * @param pzConfigFileName export variable for configuration file name (input file).
- * @param pLogFile export variable for log file object - output file (struct FileEx).
- * @return int success status.
- */
-int parseCmdArgs(int argc, char** argv, const char** pzConfigFileName, FileEx* pLogFile)
-{
-	int success = FALSE;
-	
-	if (argc != 3)
-	{
-		printf("Correct Usage:\n");
-        printf("%s <input_filename> <output_filename>\n", argv[0]);		
-	}
-	else
-	{
-		*pzConfigFileName = argv[1];
-		pLogFile->fptr = NULL;
-		pLogFile->zFileName = argv[2];
-		success = TRUE;
-	}	
-	
-	return success;
-}
-
-/**************************************************************************************************/
-/**
- * @brief Read the fixed (mandatory configs) from the file.
+ * @brief Read the fixed (mandatory configs) from the file. The first tank line
+ * is the enemy, the second one is the player.
  * 
  * @param pCfgFile configuration file object - input file (FILE*).
  * @param pRows export variable for map/canvas number of rows.
  * @param pCols export variable for map/canvas number of columns.
- * @param pPlayer export variable for player object.
  * @param pEnemy export variable for enemy object.
+ * @param pPlayer export variable for player object.
  * @return int success status.
  */
 static int readFixedConfigs(FILE* pCfgFile, int* pRows, int* pCols, 
-										GameObj* pPlayer, GameObj* pEnemy)
+										GameObj* pEnemy, GameObj* pPlayer)
 {
 	int isSuccess = TRUE;
 
 	int nItems = fscanf(pCfgFile, "%d %d ", pRows, pCols);
 	isSuccess = isSuccess && (nItems == 2);
-	nItems = fscanf(pCfgFile, "%d %d %c ", &(pPlayer->row), &(pPlayer->col), &(pPlayer->direction));
-	isSuccess = isSuccess && (nItems == 3);
 	nItems = fscanf(pCfgFile, "%d %d %c ", &(pEnemy->row), &(pEnemy->col), &(pEnemy->direction));
+	isSuccess = isSuccess && (nItems == 3);
+	nItems = fscanf(pCfgFile, "%d %d %c ", &(pPlayer->row), &(pPlayer->col), &(pPlayer->direction));
 	isSuccess = isSuccess && (nItems == 3);	
 
 	return isSuccess;
@@ -215,42 +240,57 @@ static int readFixedConfigs(FILE* pCfgFile, int* pRows, int* pCols,
  * @param rows map/canvas number of rows.
  * @param cols map/canvas number of columns.
  * @param ppMapInfo export variable for map object (struct MapInfo).
- * @param pEnemy export variable for enemy object.
+ * @param pEnemy the enemy on the fixed config line.
+ * @param ppEnemies export variable for enemy set object.
  * @param pPlayer export variable for player object.
  * @param ppMirrorList export variable for enemy mirror linked list.
  * @param ppLogList export variable for log linked list.
+ * @param piLoadError export variable for the error if invalid (LOAD_...).
  * @return int success status.
  */
 static int initGameElements(FILE* pCfgFile, int rows, int cols, 
 								MapInfo** ppMapInfo, 
 								GameObj* pEnemy, 
+								EnemySet** ppEnemies, 
 								GameObj* pPlayer, 
 								LinkedList** ppMirrorList, 
-								LinkedList** ppLogList)
+								LinkedList** ppLogList,
+								int* piLoadError)
 {
 	RefreshMapParam oRP;
 	int isSuccess = TRUE;
 	*ppMapInfo = createMap(rows, cols);
+	*ppEnemies = createEnemySet(cols);
 		
 	/* Check if tanks in bounds */
-	isSuccess = validateObjBounds(*ppMapInfo, pPlayer, "Player out of bounds.\n") && 
-				validateObjBounds(*ppMapInfo, pEnemy, "Enemy out of bounds.\n");
+	if (!validateObjBounds(*ppMapInfo, pPlayer))
+	{
+		*piLoadError = LOAD_PLAYER_BOUNDS;
+		isSuccess = FALSE;
+	}
+	else if (!validateObjBounds(*ppMapInfo, pEnemy))
+	{
+		*piLoadError = LOAD_ENEMY_BOUNDS;
+		isSuccess = FALSE;
+	}
 				
 	if (isSuccess)
 	{
+		addEnemy(*ppEnemies, pEnemy);
 		*ppMirrorList = createLinkedList();
 		*ppLogList = createLinkedList();
 				
-		/* Read mirrors from the file to a LinkedList.
+		/* Read mirrors (and extra enemies) from the file to a LinkedList.
 		   Variable configs in the file will be read. */
-		isSuccess = addMirrorsToList(pCfgFile, *ppMirrorList, *ppMapInfo, pEnemy, pPlayer);		
+		isSuccess = addMirrorsToList(pCfgFile, *ppMirrorList, *ppMapInfo, *ppEnemies, pPlayer,
+																			piLoadError);
 	}
 
 	/* Place the elemnts on the map before validating tanks with mirrors */
-	packRefreshParams(&oRP, *ppMapInfo, pEnemy, pPlayer, NULL, 
+	packRefreshParams(&oRP, *ppMapInfo, *ppEnemies, pPlayer, NULL, 
                                     *ppMirrorList, *ppLogList, NULL, FALSE);
-	refreshMapEx(&oRP, FALSE);
-	isSuccess = isSuccess && validateTanks(*ppMapInfo, pEnemy, pPlayer);
+	rebuildMap(&oRP);
+	isSuccess = isSuccess && validateTanks(*ppMapInfo, *ppEnemies, pPlayer, piLoadError);
 
 	return isSuccess;
 }
@@ -260,16 +300,21 @@ static int initGameElements(FILE* pCfgFile, int rows, int cols,
  * @brief Destroy game elements (map, mirror, log).
  * 
  * @param ppMapInfo map object (struct MapInfo).
+ * @param ppEnemies enemy set object.
  * @param ppMirrorList mirrors linked list.
  * @param ppLogList log linked list.
  */
 static void destroyGameElements(MapInfo** ppMapInfo, 
+								EnemySet** ppEnemies, 
 								LinkedList** ppMirrorList, 
 								LinkedList** ppLogList)
 {
 	if (*ppMapInfo)		
 		destroyMap(*ppMapInfo);
 	
+	if (*ppEnemies)		
+		destroyEnemySet(*ppEnemies);
+	
 	if (*ppMirrorList)		
 		freeLinkedList(*ppMirrorList, &cleanNodeMirror);
 				
@@ -277,54 +322,64 @@ static void destroyGameElements(MapInfo** ppMapInfo,
 		freeLinkedList(*ppLogList, &cleanNodeMirror);
 	
 	*ppMapInfo = NULL;
+	*ppEnemies = NULL;
 	*ppMirrorList = NULL;
 	*ppLogList = NULL;	
 } 
 
 /**************************************************************************************************/
 /**
- * @brief Initialize the game enviornment. Fails if validations fail.
+ * @brief Initialize the game enviornment. Fails if validations fail, nothing
+ * is printed: the caller reports the error (refer loadErrorMessage()).
  * 
  * @param zCfgFileName configuration file name (input file).
  * @param ppMapInfo export variable for map object (struct MapInfo).
- * @param pEnemy export variable for enemy object.
+ * @param ppEnemies export variable for enemy set object.
  * @param pPlayer export variable for player object.
  * @param ppMirrorList export variable for enemy mirror linked list.
  * @param ppLogList export variable for log linked list.
+ * @param piLoadError export variable for the error, LOAD_OK on success.
  * @return int success status.
  */
 int initGame(const char* zCfgFileName, MapInfo** ppMapInfo, 
-				GameObj* pEnemy, GameObj* pPlayer, 
-				LinkedList** ppMirrorList, LinkedList** ppLogList)
+				EnemySet** ppEnemies, GameObj* pPlayer, 
+				LinkedList** ppMirrorList, LinkedList** ppLogList, int* piLoadError)
 {
 	int rows, cols, isSuccess = TRUE;
 	FILE* pCfgFile = NULL;
+	GameObj enemy;
 	
 	*ppMapInfo = NULL;
+	*ppEnemies = NULL;
 	*ppMirrorList = NULL;
 	*ppLogList = NULL;
+	*piLoadError = LOAD_OK;
 	
 	/* Open the file to read the configs */
 	pCfgFile = fopen(zCfgFileName, "r");
 	isSuccess = (pCfgFile != NULL);
 	if (!isSuccess)
-	{
-		printError("Input file cannot be opened: "); printf("%s\n", zCfgFileName);
-	}
+		*piLoadError = LOAD_FILE_ERROR;
 
 	/* Reading fixed configs from file */
-	isSuccess = isSuccess && readFixedConfigs(pCfgFile, &rows, &cols, pPlayer, pEnemy);
+	if (isSuccess && !readFixedConfigs(pCfgFile, &rows, &cols, &enemy, pPlayer))
+	{
+		*piLoadError = LOAD_FORMAT_ERROR;
+		isSuccess = FALSE;
+	}
 
 	/* If fixed file config reading is success */
 	if (isSuccess)	
 		isSuccess = initGameElements(pCfgFile, rows, cols, 
 										ppMapInfo, 
-										pEnemy, 
+										&enemy, 
+										ppEnemies, 
 										pPlayer, 
 										ppMirrorList, 
-										ppLogList);
+										ppLogList,
+										piLoadError);
 	if (!isSuccess)	
-		destroyGameElements(ppMapInfo, ppMirrorList, ppLogList);
+		destroyGameElements(ppMapInfo, ppEnemies, ppMirrorList, ppLogList);
 	
 	if (pCfgFile)
 		fclose(pCfgFile);
@@ -332,19 +387,50 @@ int initGame(const char* zCfgFileName, MapInfo** ppMapInfo,
 	return isSuccess;
 }
 
+/**************************************************************************************************/
+/**
+ * @brief Message of a level load error, for the caller of initGame() to report.
+ * 
+ * @param loadError load error (LOAD_...).
+ * @return const char* message, without a new line.
+ */
+const char* loadErrorMessage(int loadError)
+{
+	static const char* azMessages[] =
+	{
+		"No error",
+		"Input file cannot be opened",
+		"Input file must start with the map size, an enemy and the player",
+		"Player out of bounds.",
+		"Enemy out of bounds.",
+		"Player and enemy cannot start on the same cell.",
+		"Enemies cannot start on the same cell.",
+		"Enemy must not overlap mirror",
+		"Cannot place tanks in instant lose position.",
+		"Mirror must be placed inside bounds",
+		"Mirror must not overlap player",
+		"Mirror must not overlap enemy"
+	};
+
+	return BETWEEN(LOAD_OK, LOAD_MIRROR_ON_ENEMY, loadError) ? azMessages[loadError] :
+																"Unknown error";
+}
+
 /**************************************************************************************************/
 /**
  * @brief Exit from the game enviornment. Destroy any dynamic allocations in the 
  * game enviornment.
  * 
  * @param pMapInfo map object (struct MapInfo).
+ * @param pEnemies enemy set object.
  * @param pMirrorList mirror linked list.
  * @param pLogList log linked list.
  */
-void exitGame(MapInfo* pMapInfo, LinkedList* pMirrorList, LinkedList* pLogList)
+void exitGame(MapInfo* pMapInfo, EnemySet* pEnemies, LinkedList* pMirrorList, LinkedList* pLogList)
 {
 		/* Destroy the map in main() */
 		destroyMap(pMapInfo);
+		destroyEnemySet(pEnemies);
 
 		printInfo("\n----------------------------\n");
 		printInfo("Print Log Linked List\n");
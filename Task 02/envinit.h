@@ -5,13 +5,13 @@
 #include "linkedlist.h"
 
 /* Initialization / Deinitialization Methods */
-int parseCmdArgs(int argc, char** argv, 
-                    const char** pzCfgFileName, FileEx* pLogFile);
-
 int initGame(const char* zCfgFileName, MapInfo** ppMapInfo, 
-				GameObj* pEnemy, GameObj* pPlayer, 
-				LinkedList** ppMirrorList, LinkedList** ppLogList);
+				struct EnemySet** ppEnemies, GameObj* pPlayer, 
+				LinkedList** ppMirrorList, LinkedList** ppLogList, int* piLoadError);
+
+const char* loadErrorMessage(int loadError);
 
-void exitGame(MapInfo* pMapInfo, LinkedList* pMirrorList, LinkedList* pLogList);
+void exitGame(MapInfo* pMapInfo, struct EnemySet* pEnemies, 
+				LinkedList* pMirrorList, LinkedList* pLogList);
 
 #endif
\ No newline at end of file
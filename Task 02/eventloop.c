@@ -0,0 +1,235 @@
+/* PURPOSE: Event loop of the Tank Game. Waits on stdin, a timerfd (frame
+ * ticks) and a signalfd with epoll and drives the game through callbacks.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+#define _DEFAULT_SOURCE
+
+/* Standard Include */
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/signalfd.h>
+
+/* Local Includes */
+#include "eventloop.h"
+#include "macros.h"
+
+/**************************************************************************************************/
+/* Helper Methods														    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief The signals that end the loop (delivered through the signalfd).
+ *
+ * @param pMask export variable for the signal set.
+ */
+static void fillStopSignals(sigset_t* pMask)
+{
+	sigemptyset(pMask);
+	sigaddset(pMask, SIGINT);
+	sigaddset(pMask, SIGTERM);
+	sigaddset(pMask, SIGHUP);
+}
+
+/**************************************************************************************************/
+/* Event Loop Managment Methods											    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Create an event loop on stdin and a (disarmed) frame tick timer. The
+ * stop signals are blocked and read from a signalfd instead, so the game can 
+ * clean up (restore the terminal, save the log) before it exits.
+ *
+ * @param pOnInput callback when stdin can be read without blocking.
+ * @param pOnTick callback on every frame tick.
+ * @param pContext passed to the callbacks.
+ * @return EventLoop* event loop object.
+ */
+EventLoop* createEventLoop(EventHandler pOnInput, EventHandler pOnTick, void* pContext)
+{
+	struct epoll_event event;
+	sigset_t mask;
+	EventLoop* pLoop = (EventLoop*) malloc(sizeof(EventLoop));
+
+	fillStopSignals(&mask);
+	sigprocmask(SIG_BLOCK, &mask, NULL);
+
+	pLoop->epollFd = epoll_create1(0);
+	pLoop->timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+	pLoop->signalFd = signalfd(-1, &mask, SFD_NONBLOCK);
+	pLoop->isTimerArmed = FALSE;
+	pLoop->isInputWatched = TRUE;
+	pLoop->pOnInput = pOnInput;
+	pLoop->pOnTick = pOnTick;
+	pLoop->pContext = pContext;
+
+	event.events = EPOLLIN;
+	event.data.fd = pLoop->timerFd;
+	epoll_ctl(pLoop->epollFd, EPOLL_CTL_ADD, pLoop->timerFd, &event);
+
+	event.data.fd = pLoop->signalFd;
+	epoll_ctl(pLoop->epollFd, EPOLL_CTL_ADD, pLoop->signalFd, &event);
+
+	/* A redirected file is rejected by epoll (EPERM), it never blocks anyway */
+	event.data.fd = STDIN_FILENO;
+	pLoop->isInputPollable = (epoll_ctl(pLoop->epollFd, EPOLL_CTL_ADD, STDIN_FILENO, &event) == 0);
+
+	return pLoop;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy the event loop object and unblock the stop signals. Call
+ * free().
+ *
+ * @param pLoop event loop object.
+ */
+void destroyEventLoop(EventLoop* pLoop)
+{
+	sigset_t mask;
+
+	fillStopSignals(&mask);
+	sigprocmask(SIG_UNBLOCK, &mask, NULL);
+
+	close(pLoop->signalFd);
+	close(pLoop->timerFd);
+	close(pLoop->epollFd);
+	free(pLoop);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Start the frame ticks (every TICK_INTERVAL_NS), if not started yet.
+ *
+ * @param pLoop event loop object.
+ */
+void armTickTimer(EventLoop* pLoop)
+{
+	struct itimerspec spec;
+
+	if (!pLoop->isTimerArmed)
+	{
+		spec.it_interval.tv_sec = 0;
+		spec.it_interval.tv_nsec = TICK_INTERVAL_NS;
+		spec.it_value = spec.it_interval;
+		timerfd_settime(pLoop->timerFd, 0, &spec, NULL);
+		pLoop->isTimerArmed = TRUE;
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Stop the frame ticks. A pending tick is dropped.
+ *
+ * @param pLoop event loop object.
+ */
+void disarmTickTimer(EventLoop* pLoop)
+{
+	struct itimerspec spec;
+	uint64_t nExpirations;
+
+	if (pLoop->isTimerArmed)
+	{
+		spec.it_interval.tv_sec = 0;
+		spec.it_interval.tv_nsec = 0;
+		spec.it_value = spec.it_interval;
+		timerfd_settime(pLoop->timerFd, 0, &spec, NULL);
+		pLoop->isTimerArmed = FALSE;
+
+		if (read(pLoop->timerFd, &nExpirations, sizeof(nExpirations)) < 0)
+			nExpirations = 0;
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Whether to deliver the stdin events. Stop watching stdin when there
+ * is no room for more keys or at the end of file, else epoll keeps waking up.
+ *
+ * @param pLoop event loop object.
+ * @param isWatched whether to watch stdin.
+ */
+void watchInput(EventLoop* pLoop, int isWatched)
+{
+	struct epoll_event event;
+
+	if (pLoop->isInputWatched != isWatched && pLoop->isInputPollable)
+	{
+		event.events = isWatched ? EPOLLIN : 0;
+		event.data.fd = STDIN_FILENO;
+		epoll_ctl(pLoop->epollFd, EPOLL_CTL_MOD, STDIN_FILENO, &event);
+	}
+
+	pLoop->isInputWatched = isWatched;
+}
+
+/**************************************************************************************************/
+/* Event Dispatch Methods												    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Wait for the events and dispatch them to the callbacks until a
+ * callback returns a game status other than PROGRESSING, or a stop signal 
+ * arrives (INPUT_CLOSED). A regular file on stdin is always ready, it is read
+ * once per wake up.
+ *
+ * @param pLoop event loop object.
+ * @return GameStatus game status other than PROGRESSING.
+ */
+GameStatus runEventLoop(EventLoop* pLoop)
+{
+	GameStatus gameStatus = PROGRESSING;
+	struct epoll_event aEvents[EVENT_LOOP_MAX_EVENTS];
+	uint64_t nExpirations;
+	struct signalfd_siginfo sigInfo;
+	int i, nEvents, isFileReady;
+
+	while (gameStatus == PROGRESSING)
+	{
+		isFileReady = (!pLoop->isInputPollable && pLoop->isInputWatched);
+		nEvents = 0;
+
+		if (!pLoop->isTimerArmed && !pLoop->isInputWatched)
+		{
+			/* Nothing left to wait for */
+			gameStatus = INPUT_CLOSED;
+		}
+		else
+		{
+			nEvents = epoll_wait(pLoop->epollFd, aEvents, EVENT_LOOP_MAX_EVENTS,
+										(isFileReady && !pLoop->isTimerArmed) ? 0 : -1);
+
+			if (nEvents < 0 && errno != EINTR)
+				gameStatus = INPUT_CLOSED;
+		}
+
+		for (i = 0; gameStatus == PROGRESSING && i < nEvents; i++)
+		{
+			if (aEvents[i].data.fd == pLoop->signalFd)
+			{
+				if (read(pLoop->signalFd, &sigInfo, sizeof(sigInfo)) > 0)
+					gameStatus = INPUT_CLOSED;
+			}
+			else if (aEvents[i].data.fd == pLoop->timerFd)
+			{
+				/* A late wake up still steps a single tick, no frame is dropped */
+				if (read(pLoop->timerFd, &nExpirations, sizeof(nExpirations)) > 0 &&
+						pLoop->isTimerArmed)
+					gameStatus = pLoop->pOnTick(pLoop->pContext);
+			}
+			else if (pLoop->isInputWatched)
+			{
+				gameStatus = pLoop->pOnInput(pLoop->pContext);
+			}
+		}
+
+		if (gameStatus == PROGRESSING && isFileReady && pLoop->isInputWatched)
+			gameStatus = pLoop->pOnInput(pLoop->pContext);
+	}
+
+	return gameStatus;
+}
@@ -0,0 +1,33 @@
+#ifndef EVENTLOOP_H
+#define EVENTLOOP_H
+
+#include "macros.h"
+
+/* Callback of an event source, the loop runs while it returns PROGRESSING */
+typedef GameStatus (*EventHandler)(void* pContext);
+
+/* Object Definitions */
+typedef struct EventLoop
+{
+	int epollFd;
+	int timerFd;			/* frame ticks */
+	int signalFd;			/* SIGINT, SIGTERM and SIGHUP end the loop */
+	int isTimerArmed;
+	int isInputPollable;	/* FALSE if stdin is a regular file (always ready) */
+	int isInputWatched;		/* whether to deliver the stdin events */
+	EventHandler pOnInput;
+	EventHandler pOnTick;
+	void* pContext;			/* passed to the callbacks */
+} EventLoop;
+
+/* Event Loop Managment Methods */
+EventLoop* createEventLoop(EventHandler pOnInput, EventHandler pOnTick, void* pContext);
+void destroyEventLoop(EventLoop* pLoop);
+void armTickTimer(EventLoop* pLoop);
+void disarmTickTimer(EventLoop* pLoop);
+void watchInput(EventLoop* pLoop, int isWatched);
+
+/* Event Dispatch Methods */
+GameStatus runEventLoop(EventLoop* pLoop);
+
+#endif
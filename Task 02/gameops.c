@@ -8,542 +8,504 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <ctype.h>
+#include <unistd.h>
 
 /* Local Includes */
 #include "util.h"
 #include "macros.h"
 #include "gameops.h"
-#include "validate.h"
+#include "gamesim.h"
+#include "render.h"
+#include "bullet.h"
+#include "eventloop.h"
+#include "terminal.h"
 
 /**************************************************************************************************/
 /* Forward Declarations													    		      		  */
 /**************************************************************************************************/
-static int animate(RefreshMapParam* pRP, GameObj* pStCell);
+static GameStatus stepTick(RefreshMapParam* pRP, int isSkipping);
 
 /**************************************************************************************************/
 /* Helper Methods												    		      				  */
 /**************************************************************************************************/
 /**
- * @brief Whether the player or enemy got hit by the bullet.
+ * @brief Read the keys available on stdin into the queue. Called when stdin
+ * is ready, it does not block. The keys of a line are a batch, the line end
+ * is queued too.
  * 
- * @param pBlow blow object ('X') coordinates.
- * @param pPlayer player object.
- * @return GameStatus hit game status (PLAYER_HIT, ENEMY_HIT) 
+ * @param pQueue queue of the pending keys.
  */
-static GameStatus getHitStatus(GameObj* pBlow, GameObj* pPlayer)
+void pollUserInput(InputQueue* pQueue)
 {
-	GameStatus gameStatus = ENEMY_HIT;
-	
-	if ( pBlow->row == pPlayer->row &&
-		  pBlow->col == pPlayer->col )
+	char acBuffer[INPUT_QUEUE_CAPACITY];
+	int i, nRead = 0;
+
+	if (pQueue->nKeys < INPUT_QUEUE_CAPACITY)
 	{
-		gameStatus = PLAYER_HIT;
+		nRead = read(STDIN_FILENO, acBuffer, INPUT_QUEUE_CAPACITY - pQueue->nKeys);
+
+		if (nRead == 0)
+			pQueue->isEof = TRUE;
+	}
+
+	for (i = 0; i < nRead; i++)
+	{
+		if (acBuffer[i] == KEY_LINE_END || !isspace((unsigned char) acBuffer[i]))
+		{
+			pQueue->acKeys[(pQueue->head + pQueue->nKeys) % INPUT_QUEUE_CAPACITY] = acBuffer[i];
+			pQueue->nKeys++;
+		}
 	}
-	
-	return gameStatus;
 }
 
 /**************************************************************************************************/
 /**
- * @brief Prompt the controls and read the user input.
+ * @brief Take the next key out of the queue, the line ends are dropped.
  * 
- * @param pcUserInput user input (character).
+ * @param pQueue queue of the pending keys.
+ * @param pcKey export variable for the key.
+ * @return int FALSE if the queue is empty.
  */
-void readUserInput(char* pcUserInput)
+static int popKey(InputQueue* pQueue, char* pcKey)
 {
-	/* MENU: */
-	printf("%c to go/face up\n", KEY_UP);
-	printf("%c to go/face down\n", KEY_DOWN);
-	printf("%c to go/face left\n", KEY_LEFT);
-	printf("%c to go/face right\n", KEY_RIGHT);
-	printf("%c to shoot laser\n", KEY_SHOOT);
-	printf("%c to print log file\n", KEY_LOG);
-	printf("action: ");
-	scanf(" %c", pcUserInput);
-	printf("\n");
+	int isPopped = FALSE;
+
+	while (!isPopped && pQueue->nKeys > 0)
+	{
+		*pcKey = pQueue->acKeys[pQueue->head];
+		pQueue->head = (pQueue->head + 1) % INPUT_QUEUE_CAPACITY;
+		pQueue->nKeys--;
+		isPopped = (*pcKey != KEY_LINE_END);
+	}
+
+	return isPopped;
 }
 
 /**************************************************************************************************/
 /**
- * @brief Game loop. Once the wining or loosing condition are met, 
- * the loop will exit.
+ * @brief Whether the batch is over: no more keys of the same line are queued.
  * 
- * @param pRP parameter object to pass across functions.
- * @return GameStatus Game status other then PROGRESSING. 
- * Refer to macros.h for other game status.
+ * @param pQueue queue of the pending keys.
+ * @return int TRUE if the batch is over.
  */
-GameStatus mainLoop(RefreshMapParam* pRP)
+static int isBatchOver(const InputQueue* pQueue)
 {
-	GameStatus gameStatus = PROGRESSING;
-	char cUserInput;
-
-	do 
-	{
-		readUserInput(&cUserInput);
-
-		switch(cUserInput)
-		{
-			/* all movement actions: */
-			case KEY_UP:
-			case KEY_DOWN:
-			case KEY_LEFT:
-			case KEY_RIGHT:			
-				gameStatus = turnOrMove(pRP, cUserInput);
-				debugObj(pRP->pPlayer, "Player");
-
-				if (gameStatus == PROGRESSING)
-					refreshMap(pRP);
-			break;
-				
-			case KEY_SHOOT:
-				pRP->isStoreMap = TRUE;
-				gameStatus = shoot(pRP);
-			break;
-
-			case KEY_LOG:
-				gameStatus = save(pRP);
-				refreshMap(pRP);
-			break;
-
-			default:
-				/* invalid user input */
-				printError("Invalid User Input\n\n");
-				refreshMap(pRP);
-			break;
-		}		
-
-	} while (gameStatus == PROGRESSING);
-	/* if object is hit, terminates while loop */
-
-	/* save the log after game ends */
-	save(pRP);
-
-	return gameStatus;
+	return (pQueue->nKeys == 0 || pQueue->acKeys[pQueue->head] == KEY_LINE_END);
 }
 
 /**************************************************************************************************/
 /**
- * @brief Process the game status and display "Win" or "Loose" message.
+ * @brief Take the skip key out of the queue, if it was typed for the shot in
+ * flight (before the next shoot key).
  * 
- * @param gameStatus game status to process.
+ * @param pQueue queue of the pending keys.
+ * @return int whether the skip key was found.
  */
-void processGameStatus(GameStatus gameStatus)
+static int takeSkipKey(InputQueue* pQueue)
 {
-	if (gameStatus == ENEMY_HIT)
-	{
-		printf("%sYou Won! :D%s\n", LIGHT_GREEN, CLEAN);
-	}
-	else if (gameStatus == PLAYER_HIT)
+	int i = 0, isFound = FALSE, isNextShot = FALSE;
+	char cKey;
+
+	while (!isFound && !isNextShot && i < pQueue->nKeys)
 	{
-		printf("%sYou Lost! :(%s\n", BRIGHT_RED, CLEAN);
+		cKey = pQueue->acKeys[(pQueue->head + i) % INPUT_QUEUE_CAPACITY];
+		isFound = (cKey == KEY_SKIP);
+		isNextShot = (cKey == KEY_SHOOT);
+		i++;
 	}
-	else if (gameStatus == SAVE_ERROR)
+
+	if (isFound)
 	{
-		printf("Game Save Error!\n");
+		/* Close the gap */
+		for (i--; i + 1 < pQueue->nKeys; i++)
+			pQueue->acKeys[(pQueue->head + i) % INPUT_QUEUE_CAPACITY] = 
+							pQueue->acKeys[(pQueue->head + i + 1) % INPUT_QUEUE_CAPACITY];
+
+		pQueue->nKeys--;
 	}
+
+	return isFound;
 }
 
 /**************************************************************************************************/
-/* Animation Related Methods														    	      */
+/**
+ * @brief Whether the prompt is a line ("action: " and the key on its own line).
+ * Not in raw mode (static footer) nor in script mode (no prompt).
+ * 
+ * @param pRP parameter object to pass across functions.
+ * @return int TRUE if line prompt.
+ */
+static int isLinePrompt(const RefreshMapParam* pRP)
+{
+	return (!pRP->pTerminal && !pRP->isHeadless);
+}
+
 /**************************************************************************************************/
 /**
- * @brief The common code for animateUp and animateDown functions.
+ * @brief Prompt the controls. The key is read by the event loop. In raw mode
+ * the menu is shown once, below the map, as a static footer.
  * 
- * @param isUp whether up animation or down animation.
- * @param animateLoop animate loop current status (TRUE / FALSE).
- * @param pStCell start cell of the animation.
- * @param stCol start column of the map.
- * @param i current column index of the map.
  * @param pRP parameter object to pass across functions.
- * @param pGameStatus export variable to send out the game status.
- * @return int whether to continue animation loop or not.
  */
-static int animateUpDownCore(int isUp, int animateLoop, GameObj* pStCell, 
-								int stCol, int i, RefreshMapParam* pRP,
-								GameStatus* pGameStatus)
+void promptUserInput(RefreshMapParam* pRP)
 {
-	pRP->isStoreMap = TRUE;
-	
-	if (pRP->pMapInfo->map[i][stCol] == '\\')
-	{		
-		updateObj(pStCell, i, (isUp ? stCol-1 : stCol+1), (isUp ? DIR_LEFT:DIR_RIGHT));		
-		*pGameStatus = animate(pRP, pStCell);
-		animateLoop = FALSE;
-	}
-	else if (pRP->pMapInfo->map[i][stCol] == '/')
+	Terminal* pTerminal = pRP->pTerminal;
+
+	if (isLinePrompt(pRP) || (pTerminal && !pTerminal->isFooterShown))
 	{
-		updateObj(pStCell, i, (!isUp ? stCol-1 : stCol+1), (!isUp ? DIR_LEFT:DIR_RIGHT));								
-		*pGameStatus = animate(pRP, pStCell);
-		animateLoop = FALSE;
-	}
-	else if (pRP->pMapInfo->map[i][stCol] == MARKER_BORDER)
-	{	
-		/* hitting border */
-		pRP->isStoreMap = (pRP->pBullet != NULL);
-		pRP->pBullet = NULL;
-		pauseAndRefreshMap(pRP);		
+		/* MENU: */
+		printf("%c to go/face up\n", KEY_UP);
+		printf("%c to go/face down\n", KEY_DOWN);
+		printf("%c to go/face left\n", KEY_LEFT);
+		printf("%c to go/face right\n", KEY_RIGHT);
+		printf("%c to shoot laser\n", KEY_SHOOT);
+		printf("%c to print log file\n", KEY_LOG);
+		printf("%c to skip the shot animation\n", KEY_SKIP);
 	}
-	else if (pRP->pMapInfo->map[i][stCol] != ' ')
-	{	
-		/* shot enemy or player */
-		GameObj blow; updateObj(&blow, i, stCol, 'X');		
-		pRP->pBullet = &blow;
-		pauseAndRefreshMap(pRP);
-		pRP->pBullet = NULL;
-		
-		*pGameStatus = getHitStatus(&blow, pRP->pPlayer);
-		animateLoop = FALSE;
+
+	if (isLinePrompt(pRP))
+	{
+		printf("action: ");
 	}
-	else
-	{		
-		/* Bullet placement */
-		GameObj bullet; updateObj(&bullet, i, stCol, '|');
-		pRP->pBullet = &bullet;
-		pauseAndRefreshMap(pRP);
+	else if (pTerminal && !pTerminal->isFooterShown)
+	{
+		/* The map is on top of the screen, the footer right below it */
+		pTerminal->isFooterShown = TRUE;
+		pTerminal->belowFooterRow = pRP->pMapInfo->rows + MENU_ROWS + 1;
 	}
 
-	return animateLoop;
+	fflush(stdout);
 }
 
 /**************************************************************************************************/
 /**
- * @brief Animate the bullet from bottom to top.
+ * @brief Show the map, or only log it while more keys of the batch follow.
  * 
  * @param pRP parameter object to pass across functions.
- * @param pStCell start cell of the animation.
- * @return GameStatus game status. Refer to macros.h for game status.
+ * @param isShown whether to print the map.
  */
-static GameStatus animateUp(RefreshMapParam* pRP, GameObj* pStCell)
-{	
-
-	int i, animateLoop = TRUE;
-	GameStatus gameStatus = PROGRESSING;
-	int stRow = pStCell->row, stCol = pStCell->col;
-
-	for(i = stRow; i >= 0 && animateLoop; i--)
-	{		
-		animateLoop = animateUpDownCore(TRUE, animateLoop, pStCell, 
-													stCol, i, pRP, &gameStatus);
-	}
-	
-	return gameStatus;
+static void refreshOrStoreMap(RefreshMapParam* pRP, int isShown)
+{
+	if (isShown)
+		refreshMap(pRP);
+	else
+		storeRefreshedMap(pRP);
 }
 
 /**************************************************************************************************/
 /**
- * @brief Animate the bullet from top to bottom.
+ * @brief Apply a user input (move, shoot, save, etc).
  * 
  * @param pRP parameter object to pass across functions.
- * @param pStCell start cell of the animation.
+ * @param cUserInput user choice (char).
+ * @param isShown whether to print the map (last key of the batch).
  * @return GameStatus game status. Refer to macros.h for game status.
  */
-static GameStatus animateDown(RefreshMapParam* pRP, GameObj* pStCell)
-{	
-	int i, animateLoop = TRUE;
+static GameStatus applyInput(RefreshMapParam* pRP, char cUserInput, int isShown)
+{
 	GameStatus gameStatus = PROGRESSING;
-	MapInfo* pMapInfo = pRP->pMapInfo;
-	int stRow = pStCell->row, stCol = pStCell->col;
-	
-	for (i = stRow ; i < pMapInfo->rows && animateLoop ; i++)
+
+	switch(cUserInput)
 	{
-		animateLoop = animateUpDownCore(FALSE, animateLoop, pStCell, 
-													stCol, i, pRP, &gameStatus);
-	}
+		/* all movement actions: */
+		case KEY_UP:
+		case KEY_DOWN:
+		case KEY_LEFT:
+		case KEY_RIGHT:			
+			gameStatus = turnOrMove(pRP, cUserInput);
+			debugObj(pRP->pPlayer, "Player");
+
+			if (gameStatus == PROGRESSING)
+				refreshOrStoreMap(pRP, isShown);
+		break;
+			
+		case KEY_SHOOT:
+			pRP->isStoreMap = TRUE;
+			gameStatus = shoot(pRP);
+		break;
+
+		case KEY_LOG:
+			gameStatus = save(pRP);
+			refreshOrStoreMap(pRP, isShown);
+		break;
+
+		case KEY_SKIP:
+			/* no shot in flight, nothing to skip */
+			refreshOrStoreMap(pRP, isShown);
+		break;
+
+		default:
+			/* invalid user input, not shown in script mode */
+			if (!pRP->isHeadless)
+				printErrorEx("Invalid User Input\n\n", pRP->isLean);
+			refreshOrStoreMap(pRP, isShown);
+		break;
+	}		
 
-	return gameStatus;	
+	return gameStatus;
 }
 
+/**************************************************************************************************/
+/* Event Loop Callbacks													    		      		  */
 /**************************************************************************************************/
 /**
- * @brief The common code for animateLeft and animateRight functions.
+ * @brief Step the ticks of the shot in flight: one tick, or all of them at
+ * once when skipping.
  * 
- * @param animateLoop animate loop current status (TRUE / FALSE).
- * @param stRow start row of the map.
- * @param i current column index of the map.
- * @param pRP parameter object (void* []) to pass across functions.
- * @param map the canvas.
- * @param pBullet bullet object (int [3]).
- * @param pPlayer player object (int [3]).
- * @param gameStatus export variable to send out the game status.
- * @return int whether to continue the animation loop or not.
+ * @param pLoop game loop object.
+ * @return GameStatus game status. Refer to macros.h for game status.
  */
+static GameStatus resolveTicks(GameLoop* pLoop)
+{
+	GameStatus gameStatus;
+
+	do
+	{
+		gameStatus = stepTick(pLoop->pRP, pLoop->isSkipping);
+
+	} while (gameStatus == PROGRESSING && pLoop->isSkipping && pLoop->pRP->pBullets->nBullets > 0);
+
+	if (pLoop->pRP->pBullets->nBullets == 0)
+	{
+		disarmTickTimer(pLoop->pEvents);
+		pLoop->isSkipping = FALSE;
+	}
+
+	return gameStatus;
+}
 
+/**************************************************************************************************/
 /**
- * @brief The common code for animateLeft and animateRight functions.
+ * @brief Apply the queued keys while no bullet is in flight, then prompt for
+ * the next key. A new shot is paced by the tick timer, or resolved at once when
+ * skipping. PERF: A batch (the keys of a line) is shown once, after its last 
+ * key, the map of every key is still logged.
  * 
- * @param isLeft whether left animation or right animation.
- * @param animateLoop animate loop current status (TRUE / FALSE).
- * @param pStCell start cell of the animation.
- * @param stCol start column of the map.
- * @param i current column index of the map.
- * @param pRP parameter object to pass across functions.
- * @param pGameStatus export variable to send out the game status.
- * @return int whether to continue animation loop or not.
+ * @param pLoop game loop object.
+ * @return GameStatus game status. Refer to macros.h for game status.
  */
-static int animateLeftRightCore(int isLeft, int animateLoop, GameObj* pStCell, 
-								int stRow, int i, RefreshMapParam* pRP,
-								GameStatus* pGameStatus)
+static GameStatus applyQueuedKeys(GameLoop* pLoop)
 {
-	pRP->isStoreMap = TRUE;
-	
-	if (pRP->pMapInfo->map[stRow][i] == '\\')
-	{		
-		updateObj(pStCell, (isLeft ? stRow-1 : stRow+1), i, (isLeft ? DIR_UP:DIR_DOWN));
-		*pGameStatus = animate(pRP, pStCell);
-		animateLoop = FALSE;
-	}
-	else if (pRP->pMapInfo->map[stRow][i] == '/')
-	{
-		updateObj(pStCell, (!isLeft ? stRow-1 : stRow+1), i, (!isLeft ? DIR_UP:DIR_DOWN));							
-		*pGameStatus = animate(pRP, pStCell);
-		animateLoop = FALSE;
-	}
-	else if (pRP->pMapInfo->map[stRow][i] == MARKER_BORDER)
-	{	
-		/* hitting border */
-		pRP->isStoreMap = (pRP->pBullet != NULL);
-		pRP->pBullet = NULL;
-		pauseAndRefreshMap(pRP);		
-	}
-	else if (pRP->pMapInfo->map[stRow][i] != ' ')
+	GameStatus gameStatus = PROGRESSING;
+	BulletPool* pPool = pLoop->pRP->pBullets;
+	char cKey;
+	int isShown;
+
+	while (gameStatus == PROGRESSING && pPool->nBullets == 0 && popKey(&(pLoop->queue), &cKey))
 	{
-		/* shot enemy or player */
-		GameObj blow; updateObj(&blow, stRow, i, 'X');
-		pRP->pBullet = &blow;
-		pauseAndRefreshMap(pRP);
-		pRP->pBullet = NULL;	
-		
-		*pGameStatus = getHitStatus(&blow, pRP->pPlayer);
-		animateLoop = FALSE;
+		isShown = isBatchOver(&(pLoop->queue));
+
+		if (!pLoop->isPrompted)
+			promptUserInput(pLoop->pRP);
+
+		if (isShown && isLinePrompt(pLoop->pRP))
+			printf("\n");
+
+		pLoop->isPrompted = !isShown;
+		gameStatus = applyInput(pLoop->pRP, cKey, isShown);
+
+		/* A shot ends the batch prompt, its frames are shown */
+		if (pLoop->isPrompted && pPool->nBullets > 0)
+		{
+			if (isLinePrompt(pLoop->pRP))
+				printf("\n");
+
+			pLoop->isPrompted = FALSE;
+		}
+
+		if (gameStatus == PROGRESSING && pPool->nBullets > 0)
+		{
+			pLoop->isSkipping = (pLoop->pOptions->isSkipAnimation || takeSkipKey(&(pLoop->queue)));
+
+			if (pLoop->isSkipping)
+				gameStatus = resolveTicks(pLoop);
+			else
+				armTickTimer(pLoop->pEvents);
+		}
 	}
-	else
+
+	if (gameStatus == PROGRESSING && pPool->nBullets == 0 && !pLoop->isPrompted)
 	{
-		/* Bullet placement */
-		GameObj bullet; updateObj(&bullet, stRow, i, '-');
-		pRP->pBullet = &bullet;
-		pauseAndRefreshMap(pRP);
+		promptUserInput(pLoop->pRP);
+		pLoop->isPrompted = TRUE;
 	}
 
-	return animateLoop;
+	watchInput(pLoop->pEvents, !pLoop->queue.isEof && pLoop->queue.nKeys < INPUT_QUEUE_CAPACITY);
+
+	return gameStatus;
 }
 
 /**************************************************************************************************/
 /**
- * @brief Animate the bullet from right to left.
+ * @brief Frame tick callback: advance the bullets in flight. Once they land,
+ * the keys typed meanwhile are applied.
  * 
- * @param pRP parameter object to pass across functions.
- * @param pStCell start cell of the animation.
+ * @param pContext game loop object.
  * @return GameStatus game status. Refer to macros.h for game status.
  */
-static GameStatus animateLeft(RefreshMapParam* pRP, GameObj* pStCell)
-{	
-	int i, animateLoop = TRUE;
-	GameStatus gameStatus = PROGRESSING;
-	int stRow = pStCell->row, stCol = pStCell->col;
-	
-	for (i = stCol ; i >= 0 && animateLoop; i--)
-	{
-		animateLoop = animateLeftRightCore(TRUE, animateLoop, pStCell, 
-												stRow, i, pRP, &gameStatus);
-	}
+static GameStatus onTick(void* pContext)
+{
+	GameLoop* pLoop = (GameLoop*) pContext;
+	GameStatus gameStatus = resolveTicks(pLoop);
+
+	if (gameStatus == PROGRESSING && pLoop->pRP->pBullets->nBullets == 0)
+		gameStatus = applyQueuedKeys(pLoop);
 
 	return gameStatus;
 }
 
 /**************************************************************************************************/
 /**
- * @brief Animate the bullet from left to right.
+ * @brief Input callback: queue the keys, then apply them unless a shot is in
+ * flight. The skip key resolves the shot in flight at once.
  * 
- * @param pRP parameter object to pass across functions.
- * @param pStCell start cell of the animation.
+ * @param pContext game loop object.
  * @return GameStatus game status. Refer to macros.h for game status.
  */
-static GameStatus animateRight(RefreshMapParam* pRP, GameObj* pStCell)
+static GameStatus onInput(void* pContext)
 {
+	GameLoop* pLoop = (GameLoop*) pContext;
+	GameStatus gameStatus = PROGRESSING;
 
-	int i, animateLoop = TRUE;
-	GameStatus gameStatus = PROGRESSING;	
-	MapInfo* pMapInfo = pRP->pMapInfo;
-	int stRow = pStCell->row, stCol = pStCell->col;
-		
-	for (i = stCol ; i < pMapInfo->cols && animateLoop; i++)
+	pollUserInput(&(pLoop->queue));
+
+	if (pLoop->pRP->pBullets->nBullets == 0)
 	{
-		animateLoop = animateLeftRightCore(FALSE, animateLoop, pStCell, 
-												stRow, i, pRP, &gameStatus);
+		gameStatus = applyQueuedKeys(pLoop);
 	}
+	else if (takeSkipKey(&(pLoop->queue)))
+	{
+		pLoop->isSkipping = TRUE;
+		gameStatus = onTick(pContext);
+	}
+
+	watchInput(pLoop->pEvents, !pLoop->queue.isEof && pLoop->queue.nKeys < INPUT_QUEUE_CAPACITY);
 
 	return gameStatus;
 }
 
 /**************************************************************************************************/
 /**
- * @brief Animate the bullet depending on the direction.
+ * @brief Game loop, driven by the events: stdin for the user input and the
+ * frame ticks while the bullets are in flight. A terminal is switched to raw
+ * mode for the loop, so every key press is applied at once. Once the wining 
+ * or loosing condition are met (or the game is interrupted), the loop will 
+ * exit.
  * 
  * @param pRP parameter object to pass across functions.
- * @param pStCell start cell of the animation.
- * @return GameStatus game status. Refer to macros.h for game status.
+ * @param pOptions game options (-s skips every shot animation).
+ * @return GameStatus Game status other then PROGRESSING. 
+ * Refer to macros.h for other game status.
  */
-static int animate(RefreshMapParam* pRP, GameObj* pStCell)
+GameStatus mainLoop(RefreshMapParam* pRP, const GameOptions* pOptions)
 {
-	GameStatus gameStatus = PROGRESSING;
+	GameStatus gameStatus;
+	GameLoop loop;
 
-	switch (pStCell->direction)
-	{
-		case DIR_UP:
-			gameStatus = animateUp(pRP, pStCell);
-		break;
+	loop.pRP = pRP;
+	loop.pOptions = pOptions;
+	loop.queue.head = 0;
+	loop.queue.nKeys = 0;
+	loop.queue.isEof = FALSE;
+	loop.isPrompted = FALSE;
+	loop.isSkipping = FALSE;
+	loop.pEvents = createEventLoop(&onInput, &onTick, &loop);
+	pRP->pTerminal = pOptions->isScript ? NULL : enterRawMode();
 
-		case DIR_DOWN:
-			gameStatus = animateDown(pRP, pStCell);
-		break;
+	/* Show the menu, then let the events drive the game */
+	gameStatus = applyQueuedKeys(&loop);
 
-		case DIR_LEFT:
-			gameStatus = animateLeft(pRP, pStCell);
-		break;
+	if (gameStatus == PROGRESSING)
+		gameStatus = runEventLoop(loop.pEvents);
+	/* if object is hit, terminates the event loop */
+
+	if (pRP->pTerminal)
+		leaveRawMode(pRP->pTerminal);
+
+	pRP->pTerminal = NULL;
+	destroyEventLoop(loop.pEvents);
+
+	/* save the log after game ends, a failed save is the outcome (exit code in script mode) */
+	if (gameStatus != SAVE_ERROR && save(pRP) == SAVE_ERROR)
+		gameStatus = SAVE_ERROR;
 
-		case DIR_RIGHT:
-			gameStatus = animateRight(pRP, pStCell);
-		break;
-	}	
-	
 	return gameStatus;
 }
 
-
-/**************************************************************************************************/
-/* Game Activities													    		      			  */
 /**************************************************************************************************/
 /**
- * @brief Proceed turn or move the player. First the player needs to turn when a 
- * key is pressed. Then the player will move on the next key press.
+ * @brief Process the game status and display "Win" or "Loose" message.
  * 
- * @param pPlayer player object.
- * @param cUserInput user choice (char).
+ * @param gameStatus game status to process.
+ * @param isLean plain text, no colors (stdout is not a terminal).
  */
-static void performTurnOrMove(GameObj* pPlayer, char cUserInput)
+void processGameStatus(GameStatus gameStatus, int isLean)
 {
-	switch(cUserInput)
+	if (gameStatus == ENEMY_HIT)
 	{
-		case 'w':
-			if (pPlayer->direction != DIR_UP)
-				pPlayer->direction = DIR_UP;
-			else
-				pPlayer->row = pPlayer->row - 1;	
-		break;
-			
-		case 's':
-			if (pPlayer->direction != DIR_DOWN)
-				pPlayer->direction = DIR_DOWN;
-			else
-				pPlayer->row = pPlayer->row  + 1;
-		break;
-			
-		case 'a':
-			if (pPlayer->direction != DIR_LEFT)
-				pPlayer->direction =  DIR_LEFT;
-			else 
-				pPlayer->col = pPlayer->col - 1;
-		break;
-			
-		case 'd':
-			if (pPlayer->direction != DIR_RIGHT)
-				pPlayer->direction =  DIR_RIGHT; 
-			else 
-				pPlayer->col = pPlayer->col + 1;			
-		break;
-			
-		default:
-			printf("Invalid Direction!\n");
-		break;
-	}	
+		printf("%sYou Won! :D%s\n", isLean ? "" : LIGHT_GREEN, isLean ? "" : CLEAN);
+	}
+	else if (gameStatus == PLAYER_HIT)
+	{
+		printf("%sYou Lost! :(%s\n", isLean ? "" : BRIGHT_RED, isLean ? "" : CLEAN);
+	}
+	else if (gameStatus == SAVE_ERROR)
+	{
+		printf("Game Save Error!\n");
+	}
 }
 
 /**************************************************************************************************/
 /**
- * @brief Turn or move the player. First the player needs to turn when a 
- * key is pressed. Then the player will move on the next key press. If the
- * player is moved to new cell, check whether enemy can shoot. If yes, shoot.
+ * @brief Exit code of the process in script mode.
  * 
- * @param pRP parameter object to pass across functions.
- * @param cUserInput user choice (char).
- * @return GameStatus game status. Refer to macros.h for game status.
+ * @param gameStatus game status (other than PROGRESSING).
+ * @return int exit code. Refer to macros.h for the exit codes.
  */
-GameStatus turnOrMove(RefreshMapParam* pRP, char cUserInput)
-{		
-	GameStatus gameStatus = PROGRESSING;
-	GameObj newPlayer = *(pRP->pPlayer);
-	GameObj stCell;
-
-	int validPosition = FALSE;
-	int hasChangedDirection = FALSE;
-	int enemyCanShoot = FALSE;	
-	
-	/* Update the direction of the player */
-	performTurnOrMove(&newPlayer, cUserInput);
-
-
-
-	/* New position (aiPlayerNew) may be just a change of direction */
-	hasChangedDirection = (pRP->pPlayer->direction != newPlayer.direction);
-
-	/* New position (aiPlayerNew) is within the bounds & not overlap enemy and mirrors */
-	validPosition = validateObjBounds(pRP->pMapInfo, &newPlayer, NULL) &&
-						!isObjOverlap(&newPlayer, pRP->pEnemy) &&
-						pRP->pMapInfo->map[newPlayer.row][newPlayer.col] == ' ';	
+int getExitCode(GameStatus gameStatus)
+{
+	int exitCode = EXIT_INPUT_CLOSED;
 
-	if (hasChangedDirection || validPosition)
-	{
-		/* Update player obj with new player obj */
-		*(pRP->pPlayer) = newPlayer;
-		pRP->isStoreMap = TRUE;
-
-		/* PERF: Check enemy can shoot, only if player has moved to a new cell */
-		if (!hasChangedDirection && validPosition)
-			enemyCanShoot = isFacingPlayer(pRP->pEnemy, pRP->pPlayer, &stCell, pRP->pMapInfo);
-	}	
-	
+	if (gameStatus == ENEMY_HIT)
+		exitCode = EXIT_WON;
+	else if (gameStatus == PLAYER_HIT)
+		exitCode = EXIT_LOST;
+	else if (gameStatus == SAVE_ERROR)
+		exitCode = EXIT_SAVE_ERROR;
 
-	if (enemyCanShoot)
-	{
-		refreshMap(pRP);
-		gameStatus = animate(pRP, &stCell);
-	}
-	
-	return gameStatus;
+	return exitCode;
 }
 
+/**************************************************************************************************/
+/* Tick Methods															    	      		  */
 /**************************************************************************************************/
 /**
- * @brief Shoot a bullet from the player. For shooting a bullet from the enemy
- * refer to `turnOrMove()` method, `enemyCanShoot` boolean.
+ * @brief Advance every bullet in flight by one cell, then show the tick. While
+ * skipping, the ticks are logged but not shown, only the outcome is shown.
  * 
  * @param pRP parameter object to pass across functions.
+ * @param isSkipping whether to skip the animation.
  * @return GameStatus game status. Refer to macros.h for game status.
  */
-GameStatus shoot(RefreshMapParam* pRP)
+static GameStatus stepTick(RefreshMapParam* pRP, int isSkipping)
 {
-	GameObj stCell = *(pRP->pPlayer);
+	GameStatus gameStatus = advanceTick(pRP);
+	BulletPool* pPool = pRP->pBullets;
 
-	switch(stCell.direction)
-	{
-		case DIR_UP:
-			stCell.row -= 1;
-		break;
-			
-		case DIR_DOWN:
-			stCell.row += 1;
-		break;
-			
-		case DIR_LEFT:
-			stCell.col -= 1;
-		break;
-			
-		case DIR_RIGHT:
-			stCell.col += 1;
-		break;
-	}	
+	/* PERF: The tick timer paces the frames, no sleep */
+	if (!isSkipping)
+		refreshMap(pRP);
+	else if (pPool->nBullets > 0 && gameStatus == PROGRESSING)
+		storeRefreshedMap(pRP);
+	else
+		refreshMap(pRP);
 
-	return animate(pRP, &stCell);
+	/* No overlay carries over to the next shot */
+	if (pPool->nBullets == 0)
+		beginOverlays(pPool);
+
+	return gameStatus;
 }
 
 /**************************************************************************************************/
@@ -571,7 +533,8 @@ void saveNodeLog(void* pData)
  * @brief Save log linked list to the output file.
  * 
  * @param pRP parameter object to pass across functions. 
- * @return GameStatus game status. Refer to macros.h for game status.
+ * @return GameStatus SAVE_ERROR if the output file could not be opened, 
+ * PROGRESSING otherwise.
  */
 GameStatus save(RefreshMapParam* pRP)
 {
@@ -585,6 +548,7 @@ GameStatus save(RefreshMapParam* pRP)
 		if ( !(pRP->pLogFile->fptr) )
 		{
 			perror("Could not open file");
+			gameStatus = SAVE_ERROR;
 		}
 		else
 		{
@@ -2,15 +2,36 @@
 #define GAMEOPS_H
 
 #include "map.h"
+#include "macros.h"
+#include "eventloop.h"
+
+/* Object Definitions */
+typedef struct InputQueue
+{
+	char acKeys[INPUT_QUEUE_CAPACITY];	/* keys read but not applied yet, line ends split the batches */
+	int head;
+	int nKeys;
+	int isEof;							/* stdin is closed */
+} InputQueue;
+
+typedef struct GameLoop
+{
+	RefreshMapParam* pRP;
+	const GameOptions* pOptions;
+	EventLoop* pEvents;
+	InputQueue queue;
+	int isPrompted;						/* the menu is shown, waiting for a key (batch) */
+	int isSkipping;						/* the shot in flight is resolved at once */
+} GameLoop;
 
 /* Helper Methods */
-void readUserInput(char* pcUserInput);
-GameStatus mainLoop(RefreshMapParam* pRP);
-void processGameStatus(GameStatus gameStatus);
+void pollUserInput(InputQueue* pQueue);
+void promptUserInput(RefreshMapParam* pRP);
+GameStatus mainLoop(RefreshMapParam* pRP, const GameOptions* pOptions);
+void processGameStatus(GameStatus gameStatus, int isLean);
+int getExitCode(GameStatus gameStatus);
 
 /* Game Activities */
-GameStatus turnOrMove(RefreshMapParam* pRP, char cUserInput);
-GameStatus shoot(RefreshMapParam* pRP);
 GameStatus save(RefreshMapParam* pRP);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,391 @@
+/* PURPOSE: Game simulation of the tank game (moves, shots, bullet ticks and
+ * hits). Nothing is printed or slept here, the callers show the map.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Local Includes */
+#include "util.h"
+#include "macros.h"
+#include "gamesim.h"
+#include "validate.h"
+#include "threat.h"
+#include "enemy.h"
+#include "bullet.h"
+#include "trace.h"
+#include "zobrist.h"
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Whether the player or enemy got hit by the bullet. A hit enemy is
+ * destroyed, the player wins once all the enemies are destroyed.
+ * 
+ * @param pBlow blow object ('X') coordinates.
+ * @param pRP parameter object to pass across functions.
+ * @return GameStatus hit game status (PLAYER_HIT, ENEMY_HIT, PROGRESSING) 
+ */
+static GameStatus getHitStatus(GameObj* pBlow, RefreshMapParam* pRP)
+{
+	GameStatus gameStatus = ENEMY_HIT;
+	int enemyIdx = findEnemyAt(pRP->pEnemies, pBlow->row, pBlow->col);
+	
+	if ( pBlow->row == pRP->pPlayer->row &&
+		  pBlow->col == pRP->pPlayer->col )
+	{
+		gameStatus = PLAYER_HIT;
+	}
+	else if (enemyIdx != -1)
+	{
+		killEnemy(pRP->pEnemies, enemyIdx);
+
+		if (pRP->pZobrist)
+			killZobristEnemy(pRP->pZobrist, pRP->pEnemies, enemyIdx);
+
+		/* PERF: Only the lines of fire through or stopped by the enemy change */
+		if (pRP->pThreat)
+		{
+			invalidateEnemyFire(pRP->pThreat, enemyIdx);
+			invalidateThreatAt(pRP->pThreat, pBlow->row, pBlow->col);
+		}
+
+		if (pRP->pEnemies->nAlive > 0)
+		{
+			/* Take the blow and the destroyed enemy off the board */
+			gameStatus = PROGRESSING;
+			rebuildMap(pRP);
+		}
+	}
+	
+	return gameStatus;
+}
+
+/**************************************************************************************************/
+/* Tick Engine Methods														    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Move the bullet one cell towards its direction.
+ * 
+ * @param pBullet bullet object.
+ */
+static void stepBullet(Bullet* pBullet)
+{
+	pBullet->row += (pBullet->direction == DIR_DOWN) - (pBullet->direction == DIR_UP);
+	pBullet->col += (pBullet->direction == DIR_RIGHT) - (pBullet->direction == DIR_LEFT);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Number of empty cells after the bullet cell, up to the next obstacle.
+ * 
+ * @param pMapInfo map object.
+ * @param pBullet bullet object.
+ * @return int number of empty cells.
+ */
+static int countClearAhead(const MapInfo* pMapInfo, const Bullet* pBullet)
+{
+	Bullet next = *pBullet;
+	int isVertical = (pBullet->direction == DIR_UP || pBullet->direction == DIR_DOWN);
+	int obstacle;
+
+	stepBullet(&next);
+	obstacle = findObstacle(pMapInfo, next.row, next.col, next.direction);
+
+	return abs(obstacle - (isVertical ? next.row : next.col));
+}
+
+/**************************************************************************************************/
+/**
+ * @brief The cell the bullet is on. The bullet is reflected on the mirrors
+ * first, no tick is spent on a mirror cell.
+ * 
+ * @param pMapInfo map object.
+ * @param pBullet bullet object.
+ * @return char the cell.
+ */
+static char resolveBulletCell(const MapInfo* pMapInfo, Bullet* pBullet)
+{
+	/* PERF: Cells before the obstacle are empty, no need to read them */
+	char cell = (pBullet->nClear > 0) ? MARKER_EMPTY : 
+								getCell(pMapInfo, pBullet->row, pBullet->col);
+
+	while (cell == MARKER_FACE_BMIRROR || cell == MARKER_FACE_FMIRROR)
+	{
+		pBullet->direction = reflectDirection(cell, pBullet->direction);
+		pBullet->nClear = 0;
+		stepBullet(pBullet);
+		cell = getCell(pMapInfo, pBullet->row, pBullet->col);
+	}
+
+	return cell;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Advance the bullet by one tick: show it on its cell, or resolve the
+ * hit (border, enemy or player).
+ * 
+ * @param pRP parameter object to pass across functions.
+ * @param pBullet bullet object.
+ * @param pGameStatus export variable to send out the hit game status.
+ * @return int whether the bullet is still in flight.
+ */
+static int advanceBullet(RefreshMapParam* pRP, Bullet* pBullet, GameStatus* pGameStatus)
+{
+	int isFlying = FALSE;
+	char cell = resolveBulletCell(pRP->pMapInfo, pBullet);
+	int isVertical = (pBullet->direction == DIR_UP || pBullet->direction == DIR_DOWN);
+	GameObj blow;
+
+	if (cell == MARKER_BORDER)
+	{
+		/* hitting border */
+		*pGameStatus = PROGRESSING;
+	}
+	else if (cell != MARKER_EMPTY)
+	{
+		/* shot enemy or player */
+		updateObj(&blow, pBullet->row, pBullet->col, 'X');
+		addOverlay(pRP->pBullets, blow.row, blow.col, blow.direction);
+		*pGameStatus = getHitStatus(&blow, pRP);
+	}
+	else
+	{
+		/* Bullet placement */
+		addOverlay(pRP->pBullets, pBullet->row, pBullet->col, isVertical ? '|' : '-');
+
+		/* PERF: Search the obstacle once per leg, the bullet then flies blind */
+		if (pBullet->nClear > 0)
+			pBullet->nClear--;
+		if (pBullet->nClear == 0)
+			pBullet->nClear = countClearAhead(pRP->pMapInfo, pBullet);
+
+		stepBullet(pBullet);
+		*pGameStatus = PROGRESSING;
+		isFlying = TRUE;
+	}
+
+	return isFlying;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Advance every bullet in flight by one cell. Nothing is shown, the
+ * caller shows (or logs) the tick. A tick is to be logged if it shows a
+ * bullet or clears the one shown before.
+ * 
+ * @param pRP parameter object to pass across functions.
+ * @return GameStatus game status. Refer to macros.h for game status.
+ */
+GameStatus advanceTick(RefreshMapParam* pRP)
+{
+	int i = 0;
+	GameStatus gameStatus = PROGRESSING, hitStatus;
+	BulletPool* pPool = pRP->pBullets;
+
+	beginOverlays(pPool);
+	while (i < pPool->nBullets)
+	{
+		if (advanceBullet(pRP, &(pPool->aBullets[i]), &hitStatus))
+			i++;
+		else
+			removeBullet(pPool, i);
+
+		/* The player being hit takes priority over the last enemy being hit */
+		if (gameStatus != PLAYER_HIT && hitStatus != PROGRESSING)
+			gameStatus = hitStatus;
+	}
+
+	pRP->isStoreMap = (pPool->nOverlays > 0 || pPool->wasShown);
+
+	return gameStatus;
+}
+
+/**************************************************************************************************/
+/* Game Activities													    		      			  */
+/**************************************************************************************************/
+/**
+ * @brief Proceed turn or move the player. First the player needs to turn when a 
+ * key is pressed. Then the player will move on the next key press.
+ * 
+ * @param pPlayer player object.
+ * @param cUserInput user choice (char).
+ */
+static void performTurnOrMove(GameObj* pPlayer, char cUserInput)
+{
+	switch(cUserInput)
+	{
+		case 'w':
+			if (pPlayer->direction != DIR_UP)
+				pPlayer->direction = DIR_UP;
+			else
+				pPlayer->row = pPlayer->row - 1;	
+		break;
+			
+		case 's':
+			if (pPlayer->direction != DIR_DOWN)
+				pPlayer->direction = DIR_DOWN;
+			else
+				pPlayer->row = pPlayer->row  + 1;
+		break;
+			
+		case 'a':
+			if (pPlayer->direction != DIR_LEFT)
+				pPlayer->direction =  DIR_LEFT;
+			else 
+				pPlayer->col = pPlayer->col - 1;
+		break;
+			
+		case 'd':
+			if (pPlayer->direction != DIR_RIGHT)
+				pPlayer->direction =  DIR_RIGHT; 
+			else 
+				pPlayer->col = pPlayer->col + 1;			
+		break;
+			
+		default:
+			/* not a direction, the player stays */
+		break;
+	}	
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Whether an enemy can shoot the player (player is in an enemy line 
+ * of fire). O(1) lookup in the precomputed threat mask when available.
+ * 
+ * @param pRP parameter object to pass across functions.
+ * @param pBulletStCell if enemy can shoot, start cell of the bullet.
+ * @return int whether the enemy can shoot or not.
+ */
+static int canEnemyShoot(RefreshMapParam* pRP, GameObj* pBulletStCell)
+{
+	int canShoot = FALSE;
+
+	int i;
+	GameObj enemy;
+
+	if (pRP->pThreat)
+	{
+		/* PERF: Only the enemies whose line of fire covers the cell */
+		canShoot = (findThreatSource(pRP->pThreat, pRP->pPlayer->row, pRP->pPlayer->col, 
+															pBulletStCell) != -1);
+	}
+	else
+	{
+		for (i = 0; !canShoot && i < pRP->pEnemies->nEnemies; i++)
+		{
+			getEnemy(pRP->pEnemies, i, &enemy);
+			canShoot = pRP->pEnemies->aIsAlive[i] &&
+						isFacingPlayer(&enemy, pRP->pPlayer, pBulletStCell, pRP->pMapInfo);
+		}
+	}
+
+	return canShoot;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Turn or move the player. First the player needs to turn when a 
+ * key is pressed. Then the player will move on the next key press. If the
+ * player is moved to new cell, check whether enemy can shoot. If yes, the
+ * enemy bullet is spawned, it flies on the following ticks.
+ * 
+ * @param pRP parameter object to pass across functions.
+ * @param cUserInput user choice (char).
+ * @return GameStatus game status. Refer to macros.h for game status.
+ */
+GameStatus turnOrMove(RefreshMapParam* pRP, char cUserInput)
+{		
+	GameStatus gameStatus = PROGRESSING;
+	GameObj newPlayer = *(pRP->pPlayer);
+	GameObj stCell;
+
+	int validPosition = FALSE;
+	int hasChangedDirection = FALSE;
+	int enemyCanShoot = FALSE;	
+	
+	/* Line of fire is recomputed (if stale) while the map holds the player's current cell */
+	if (pRP->pThreat)
+		refreshThreatMask(pRP->pThreat, pRP->pMapInfo, pRP->pEnemies, pRP->pPlayer);
+
+	/* Update the direction of the player */
+	performTurnOrMove(&newPlayer, cUserInput);
+
+	/* New position (aiPlayerNew) may be just a change of direction */
+	hasChangedDirection = (pRP->pPlayer->direction != newPlayer.direction);
+
+	/* New position (aiPlayerNew) is within the bounds & not overlap enemies and mirrors */
+	validPosition = validateObjBounds(pRP->pMapInfo, &newPlayer) &&
+						findEnemyAt(pRP->pEnemies, newPlayer.row, newPlayer.col) == -1 &&
+						getCell(pRP->pMapInfo, newPlayer.row, newPlayer.col) == ' ';	
+
+	if (hasChangedDirection || validPosition)
+	{
+		/* PERF: O(1) hash update, only the player keys change */
+		if (pRP->pZobrist)
+			moveZobristPlayer(pRP->pZobrist, pRP->pPlayer, &newPlayer);
+
+		/* Update player obj with new player obj */
+		*(pRP->pPlayer) = newPlayer;
+		pRP->isStoreMap = TRUE;
+
+		/* The bullets in flight may now run into the player */
+		if (!hasChangedDirection)
+			resetBulletLegs(pRP->pBullets);
+
+		/* PERF: Check enemy can shoot, only if player has moved to a new cell */
+		if (!hasChangedDirection && validPosition)
+			enemyCanShoot = canEnemyShoot(pRP, &stCell);
+	}	
+	
+
+	/* The enemy bullet flies from the next tick */
+	if (enemyCanShoot)
+		spawnBullet(pRP->pBullets, &stCell);
+	
+	return gameStatus;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Shoot a bullet from the player, it flies on the following ticks. For 
+ * shooting a bullet from the enemy refer to `turnOrMove()` method, 
+ * `enemyCanShoot` boolean.
+ * 
+ * @param pRP parameter object to pass across functions.
+ * @return GameStatus game status. Refer to macros.h for game status.
+ */
+GameStatus shoot(RefreshMapParam* pRP)
+{
+	GameObj stCell = *(pRP->pPlayer);
+
+	switch(stCell.direction)
+	{
+		case DIR_UP:
+			stCell.row -= 1;
+		break;
+			
+		case DIR_DOWN:
+			stCell.row += 1;
+		break;
+			
+		case DIR_LEFT:
+			stCell.col -= 1;
+		break;
+			
+		case DIR_RIGHT:
+			stCell.col += 1;
+		break;
+	}	
+
+	spawnBullet(pRP->pBullets, &stCell);
+
+	return PROGRESSING;
+}
@@ -0,0 +1,14 @@
+#ifndef GAMESIM_H
+#define GAMESIM_H
+
+#include "map.h"
+#include "macros.h"
+
+/* Tick Engine Methods */
+GameStatus advanceTick(RefreshMapParam* pRP);
+
+/* Game Activities */
+GameStatus turnOrMove(RefreshMapParam* pRP, char cUserInput);
+GameStatus shoot(RefreshMapParam* pRP);
+
+#endif
@@ -0,0 +1,502 @@
+/* PURPOSE: Random level generator: writes level files (config files of the
+ * game) with a given size, mirror density and difficulty. Each level comes
+ * from its own seeded random stream and is accepted only if the game's
+ * loader would accept it, the levels are built by a pool of threads.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+#define _DEFAULT_SOURCE
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* Local Includes */
+#include "map.h"
+#include "enemy.h"
+#include "validate.h"
+#include "threat.h"
+#include "rng.h"
+#include "toolutil.h"
+#include "macros.h"
+
+/* Object Definitions */
+typedef struct GenRange
+{
+	int lo;
+	int hi;					/* inclusive */
+} GenRange;
+
+typedef struct GenConfig
+{
+	const char* zOutDir;
+	int nLevels;
+	uint64_t seed;
+	GenRange rows;			/* border included */
+	GenRange cols;
+	GenRange enemies;
+	double mirrorDensity;	/* mirrors per interior cell */
+	int minCoverage;		/* difficulty: percent of the empty interior in a line of fire */
+	int nextLevel;			/* next level to build (atomic) */
+} GenConfig;
+
+typedef struct GenLevel
+{
+	MapInfo* pMapInfo;		/* enemies and mirrors placed, not the player */
+	EnemySet* pEnemies;
+	GameObj player;
+	GameObj* aMirrors;		/* owned by the worker, reused by its levels */
+	int nMirrors;
+} GenLevel;
+
+typedef struct GenWorker
+{
+	GenConfig* pConfig;
+	GameObj* aMirrors;
+	int mirrorCapacity;
+	int* aiStamps;			/* scratch: last coverage count through each cell */
+	long stampCapacity;
+	int stamp;
+	long nCandidates;
+	long nLowCoverage;		/* rejected: below the difficulty */
+	long nNoPlayerCell;		/* rejected: every player cell tried was in a line of fire */
+	long nInvalid;			/* rejected by the loader's validation (never expected) */
+	int nLevels;
+	int nFailed;			/* levels given up after GEN_MAX_CANDIDATES */
+	int nSaveErrors;
+} GenWorker;
+
+/* Tank facings */
+static const char acTankDirections[4] = {DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT};
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Parse a range argument: "n" or "lo-hi".
+ *
+ * @param zArg argument.
+ * @param pRange export variable for the range.
+ * @return int success status.
+ */
+static int parseRange(const char* zArg, GenRange* pRange)
+{
+	int nItems = sscanf(zArg, "%d-%d", &(pRange->lo), &(pRange->hi));
+
+	if (nItems == 1)
+		pRange->hi = pRange->lo;
+
+	return nItems >= 1 && pRange->lo <= pRange->hi;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Pick a random empty interior cell.
+ *
+ * @param pRng random number generator object.
+ * @param pMapInfo map object.
+ * @param pObj export variable for the cell (the direction is kept).
+ */
+static void pickEmptyCell(Rng* pRng, const MapInfo* pMapInfo, GameObj* pObj)
+{
+	do
+	{
+		pObj->row = rangeRng(pRng, 1, pMapInfo->rows - 2);
+		pObj->col = rangeRng(pRng, 1, pMapInfo->cols - 2);
+	} while (getCell(pMapInfo, pObj->row, pObj->col) != MARKER_EMPTY);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Percent of the empty interior cells in a straight line of fire.
+ * PERF: Each line is walked once, a cell is counted once with the stamps.
+ *
+ * @param pWorker worker object.
+ * @param pLevel level, enemies and mirrors placed.
+ * @return int coverage (0 to 100).
+ */
+static int lineOfFireCoverage(GenWorker* pWorker, const GenLevel* pLevel)
+{
+	const MapInfo* pMapInfo = pLevel->pMapInfo;
+	long key, nCells = (long) pMapInfo->rows * pMapInfo->cols, nCovered = 0;
+	long nEmpty = (long) (pMapInfo->rows - 2) * (pMapInfo->cols - 2) -
+						pLevel->pEnemies->nEnemies - pLevel->nMirrors;
+	int i, dRow, dCol;
+	GameObj cell;
+
+	if (pWorker->stampCapacity < nCells)
+	{
+		free(pWorker->aiStamps);
+		pWorker->aiStamps = (int*) calloc(nCells, sizeof(int));
+		pWorker->stampCapacity = nCells;
+		pWorker->stamp = 0;
+	}
+	pWorker->stamp++;
+
+	for (i = 0; i < pLevel->pEnemies->nEnemies; i++)
+	{
+		getEnemy(pLevel->pEnemies, i, &cell);
+		dRow = (cell.direction == DIR_DOWN) - (cell.direction == DIR_UP);
+		dCol = (cell.direction == DIR_RIGHT) - (cell.direction == DIR_LEFT);
+		cell.row += dRow;
+		cell.col += dCol;
+
+		while (getCell(pMapInfo, cell.row, cell.col) == MARKER_EMPTY)
+		{
+			key = (long) cell.row * pMapInfo->cols + cell.col;
+			nCovered += (pWorker->aiStamps[key] != pWorker->stamp);
+			pWorker->aiStamps[key] = pWorker->stamp;
+			cell.row += dRow;
+			cell.col += dCol;
+		}
+	}
+
+	return (nEmpty > 0) ? (int) (nCovered * 100 / nEmpty) : 0;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Place the player on a random cell out of every line of fire (the
+ * straight lines of the loader, the cell right in front of an enemy included).
+ *
+ * @param pRng random number generator object.
+ * @param pLevel level, enemies and mirrors placed.
+ * @return int TRUE if a cell was found.
+ */
+static int placePlayer(Rng* pRng, GenLevel* pLevel)
+{
+	int nTries = 0, isSafe = FALSE;
+	ThreatMask* pThreat = createThreatMask(pLevel->pMapInfo, pLevel->pEnemies, FALSE);
+
+	/* PERF: The lines of fire are walked once, each try is a lookup */
+	refreshThreatMask(pThreat, pLevel->pMapInfo, pLevel->pEnemies, NULL);
+
+	while (!isSafe && nTries < GEN_MAX_PLAYER_TRIES)
+	{
+		pLevel->player.direction = acTankDirections[rangeRng(pRng, 0, 3)];
+		pickEmptyCell(pRng, pLevel->pMapInfo, &(pLevel->player));
+
+		isSafe = !isThreatened(pThreat, pLevel->player.row, pLevel->player.col);
+		nTries++;
+	}
+
+	destroyThreatMask(pThreat);
+
+	return isSafe;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief The checks of the game's loader on the level (refer initGame()):
+ * the tanks in bounds, no enemy facing the player, the mirrors on free cells.
+ * The line of fire check is the loader's own (isFacingPlayer()), not the
+ * threat mask of placePlayer(), so a level starting in a line of fire is
+ * counted as invalid and never written.
+ *
+ * @param pLevel level.
+ * @return int validation status.
+ */
+static int validateLevel(GenLevel* pLevel)
+{
+	int i, loadError, isValid = validateObjBounds(pLevel->pMapInfo, &(pLevel->player)) &&
+			validateTanks(pLevel->pMapInfo, pLevel->pEnemies, &(pLevel->player), &loadError);
+
+	for (i = 0; isValid && i < pLevel->nMirrors; i++)
+	{
+		isValid = validateMirror(&(pLevel->aMirrors[i]), pLevel->pMapInfo,
+										pLevel->pEnemies, &(pLevel->player), &loadError);
+	}
+
+	return isValid;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Build a random candidate level. It is kept only if it meets the
+ * difficulty and passes the loader's validation.
+ *
+ * @param pWorker worker object.
+ * @param pRng random number generator object (the stream of the level).
+ * @param pLevel export variable for the level, destroyed if rejected.
+ * @return int TRUE if the candidate is accepted.
+ */
+static int buildCandidate(GenWorker* pWorker, Rng* pRng, GenLevel* pLevel)
+{
+	const GenConfig* pConfig = pWorker->pConfig;
+	int rows = rangeRng(pRng, pConfig->rows.lo, pConfig->rows.hi);
+	int cols = rangeRng(pRng, pConfig->cols.lo, pConfig->cols.hi);
+	int nInterior = (rows - 2) * (cols - 2);
+	int nMirrors = (int) (pConfig->mirrorDensity * nInterior + 0.5);
+	int nEnemies = rangeRng(pRng, pConfig->enemies.lo, pConfig->enemies.hi);
+	int i, isAccepted = FALSE;
+	GameObj enemy;
+
+	/* At least half the interior stays empty for the player */
+	if (nEnemies > (nInterior - nMirrors) / 2)
+		nEnemies = ((nInterior - nMirrors) / 2 > 1) ? (nInterior - nMirrors) / 2 : 1;
+
+	pLevel->pMapInfo = createMap(rows, cols);
+	pLevel->pEnemies = createEnemySet(cols);
+	pLevel->nMirrors = nMirrors;
+
+	if (nMirrors > pWorker->mirrorCapacity)
+	{
+		pWorker->mirrorCapacity = nMirrors;
+		pWorker->aMirrors = (GameObj*) realloc(pWorker->aMirrors, sizeof(GameObj) * nMirrors);
+	}
+	pLevel->aMirrors = pWorker->aMirrors;
+
+	for (i = 0; i < nEnemies; i++)
+	{
+		enemy.direction = acTankDirections[rangeRng(pRng, 0, 3)];
+		pickEmptyCell(pRng, pLevel->pMapInfo, &enemy);
+		addEnemy(pLevel->pEnemies, &enemy);
+		placeObj(pLevel->pMapInfo, &enemy);
+	}
+
+	for (i = 0; i < nMirrors; i++)
+	{
+		pLevel->aMirrors[i].direction = rangeRng(pRng, 0, 1) ? DIR_F : DIR_B;
+		pickEmptyCell(pRng, pLevel->pMapInfo, &(pLevel->aMirrors[i]));
+		placeObj(pLevel->pMapInfo, &(pLevel->aMirrors[i]));
+	}
+
+	pWorker->nCandidates++;
+
+	/* PERF: The cheap checks first, the coverage is only walked for a difficulty */
+	if (pConfig->minCoverage > 0 && lineOfFireCoverage(pWorker, pLevel) < pConfig->minCoverage)
+		pWorker->nLowCoverage++;
+	else if (!placePlayer(pRng, pLevel))
+		pWorker->nNoPlayerCell++;
+	else if (!validateLevel(pLevel))
+		pWorker->nInvalid++;
+	else
+		isAccepted = TRUE;
+
+	if (!isAccepted)
+	{
+		destroyMap(pLevel->pMapInfo);
+		destroyEnemySet(pLevel->pEnemies);
+	}
+
+	return isAccepted;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Write the level file: size, the first enemy, the player, then the
+ * other enemies and the mirrors (as the game reads them).
+ *
+ * @param pConfig generator configuration.
+ * @param levelIdx level index (file name).
+ * @param pLevel level.
+ * @return int success status.
+ */
+static int saveLevel(const GenConfig* pConfig, int levelIdx, const GenLevel* pLevel)
+{
+	char zFileName[TOOL_MAX_LINE];
+	FILE* pFile;
+	int i;
+	GameObj enemy;
+
+	sprintf(zFileName, GEN_FILE_FORMAT, pConfig->zOutDir, levelIdx);
+	pFile = fopen(zFileName, "w");
+
+	if (pFile)
+	{
+		fprintf(pFile, "%d %d\n", pLevel->pMapInfo->rows, pLevel->pMapInfo->cols);
+
+		for (i = 0; i < pLevel->pEnemies->nEnemies; i++)
+		{
+			getEnemy(pLevel->pEnemies, i, &enemy);
+			fprintf(pFile, "%d %d %c\n", enemy.row, enemy.col, enemy.direction);
+
+			if (i == 0)
+			{
+				fprintf(pFile, "%d %d %c\n", pLevel->player.row, pLevel->player.col,
+								pLevel->player.direction);
+			}
+		}
+
+		for (i = 0; i < pLevel->nMirrors; i++)
+		{
+			fprintf(pFile, "%d %d %c\n", pLevel->aMirrors[i].row, pLevel->aMirrors[i].col,
+							pLevel->aMirrors[i].direction);
+		}
+
+		fclose(pFile);
+	}
+	else
+		perror(zFileName);
+
+	return pFile != NULL;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Thread body: build levels until none is left. A level only depends
+ * on the seed and its index, not on the thread that builds it.
+ *
+ * @param pArg worker object.
+ * @return void* NULL.
+ */
+static void* runWorker(void* pArg)
+{
+	GenWorker* pWorker = (GenWorker*) pArg;
+	GenConfig* pConfig = pWorker->pConfig;
+	int nTries, isAccepted, levelIdx = __atomic_fetch_add(&(pConfig->nextLevel), 1, __ATOMIC_RELAXED);
+	GenLevel level;
+	Rng rng;
+
+	while (levelIdx < pConfig->nLevels)
+	{
+		seedRng(&rng, pConfig->seed, (uint64_t) levelIdx);
+		isAccepted = FALSE;
+
+		for (nTries = 0; !isAccepted && nTries < GEN_MAX_CANDIDATES; nTries++)
+			isAccepted = buildCandidate(pWorker, &rng, &level);
+
+		if (isAccepted)
+		{
+			pWorker->nLevels++;
+			pWorker->nSaveErrors += !saveLevel(pConfig, levelIdx, &level);
+			destroyMap(level.pMapInfo);
+			destroyEnemySet(level.pEnemies);
+		}
+		else
+			pWorker->nFailed++;
+
+		levelIdx = __atomic_fetch_add(&(pConfig->nextLevel), 1, __ATOMIC_RELAXED);
+	}
+
+	return NULL;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Build all the levels.
+ *
+ * @param pConfig generator configuration.
+ * @param nWorkers number of threads.
+ * @param pTotal export variable for the counts over all the threads.
+ */
+static void generateLevels(GenConfig* pConfig, int nWorkers, GenWorker* pTotal)
+{
+	GenWorker* aWorkers = (GenWorker*) calloc(nWorkers, sizeof(GenWorker));
+	int i;
+
+	for (i = 0; i < nWorkers; i++)
+		aWorkers[i].pConfig = pConfig;
+
+	runWorkers(aWorkers, sizeof(GenWorker), nWorkers, &runWorker);
+	memset(pTotal, 0, sizeof(GenWorker));
+
+	for (i = 0; i < nWorkers; i++)
+	{
+		pTotal->nCandidates += aWorkers[i].nCandidates;
+		pTotal->nLowCoverage += aWorkers[i].nLowCoverage;
+		pTotal->nNoPlayerCell += aWorkers[i].nNoPlayerCell;
+		pTotal->nInvalid += aWorkers[i].nInvalid;
+		pTotal->nLevels += aWorkers[i].nLevels;
+		pTotal->nFailed += aWorkers[i].nFailed;
+		pTotal->nSaveErrors += aWorkers[i].nSaveErrors;
+		free(aWorkers[i].aMirrors);
+		free(aWorkers[i].aiStamps);
+	}
+
+	free(aWorkers);
+}
+
+/**************************************************************************************************/
+/* Main Entry															    		      		  */
+/**************************************************************************************************/
+int main(int argc, char *argv[])
+{
+	GenConfig config;
+	GenWorker total;
+	struct timespec start;
+	double timeMs;
+	int i, isValid = (argc >= 3), nWorkers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	int exitCode = EXIT_INIT_ERROR;
+
+	memset(&config, 0, sizeof(GenConfig));
+	config.seed = 1;
+	config.rows.lo = 8;
+	config.rows.hi = 24;
+	config.cols.lo = 8;
+	config.cols.hi = 40;
+	config.enemies.lo = 1;
+	config.enemies.hi = 4;
+	config.mirrorDensity = 0.05;
+
+	/* Optional flags after the output directory and the count */
+	for (i = 3; isValid && i < argc; i++)
+	{
+		if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+			config.seed = strtoul(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+			nWorkers = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+			isValid = parseRange(argv[++i], &(config.rows));
+		else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+			isValid = parseRange(argv[++i], &(config.cols));
+		else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc)
+			isValid = parseRange(argv[++i], &(config.enemies));
+		else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+			config.mirrorDensity = atof(argv[++i]);
+		else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+			config.minCoverage = atoi(argv[++i]);
+		else
+			isValid = FALSE;
+	}
+
+	if (isValid)
+	{
+		config.zOutDir = argv[1];
+		config.nLevels = atoi(argv[2]);
+		isValid = config.nLevels > 0 && nWorkers >= 1 &&
+					config.rows.lo >= GEN_MIN_SIZE && config.cols.lo >= GEN_MIN_SIZE &&
+					config.enemies.lo >= 1 && BETWEEN(0, 100, config.minCoverage) &&
+					config.mirrorDensity >= 0 && config.mirrorDensity <= GEN_MAX_DENSITY;
+	}
+
+	if (!isValid)
+	{
+		printf("Usage: %s <output dir> <count> [-s seed] [-t threads] [-r rows] [-c cols]\n"
+				"          [-e enemies] [-p mirror density] [-d difficulty]\n", argv[0]);
+		printf("  -s  seed, the same seed gives the same levels (default: 1)\n");
+		printf("  -t  number of worker threads (default: one per core)\n");
+		printf("  -r  rows, border included: n or lo-hi (default: 8-24, at least %d)\n",
+					GEN_MIN_SIZE);
+		printf("  -c  columns, border included: n or lo-hi (default: 8-40, at least %d)\n",
+					GEN_MIN_SIZE);
+		printf("  -e  enemies: n or lo-hi (default: 1-4)\n");
+		printf("  -p  mirrors per interior cell (default: 0.05, at most %.1f)\n",
+					GEN_MAX_DENSITY);
+		printf("  -d  percent of the empty cells in a line of fire, at least (default: 0)\n");
+	}
+	else
+	{
+		mkdir(config.zOutDir, 0777);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		generateLevels(&config, nWorkers, &total);
+		timeMs = elapsedMs(&start);
+
+		printf("%d levels (%ld candidates: %ld below the difficulty, %ld without a safe "
+					"player cell, %ld invalid), %d given up\n",
+					total.nLevels, total.nCandidates, total.nLowCoverage, total.nNoPlayerCell,
+					total.nInvalid, total.nFailed);
+		printf("%d threads, %.1f ms, %.0f levels/s\n", nWorkers, timeMs,
+					total.nLevels * 1000.0 / (timeMs > 0 ? timeMs : 1));
+
+		exitCode = (total.nSaveErrors > 0) ? EXIT_SAVE_ERROR : EXIT_SUCCESS;
+	}
+
+	return exitCode;
+}
@@ -13,6 +13,133 @@
 #define MARKER_FACE_DOWN    'v'
 #define MARKER_FACE_BMIRROR '\\'
 #define MARKER_FACE_FMIRROR '/'
+#define MARKER_EMPTY        ' '
+
+/* Map Tiles (sparse map storage, 64x64 cells per tile) */
+#define MAP_TILE_SHIFT      6
+#define MAP_TILE_SIZE       (1 << MAP_TILE_SHIFT)
+#define MAP_TILE_MASK       (MAP_TILE_SIZE - 1)
+#define MAP_TILE_CELLS      (MAP_TILE_SIZE * MAP_TILE_SIZE)
+#define MAP_TILE_INDEX(pMapInfo, row, col) \
+            (((row) >> MAP_TILE_SHIFT) * (pMapInfo)->tileCols + ((col) >> MAP_TILE_SHIFT))
+#define MAP_CELL_OFFSET(row, col) \
+            ((((row) & MAP_TILE_MASK) << MAP_TILE_SHIFT) | ((col) & MAP_TILE_MASK))
+#define MAP_INIT_TILE_CAPACITY 8
+
+/* Bitboard (occupancy bit sets, maps up to 64 columns) */
+#define BITBOARD_MAX_COLS   64
+#define BITBOARD_WORD_SHIFT 6
+#define BITBOARD_WORD_BITS  (1 << BITBOARD_WORD_SHIFT)
+#define BITBOARD_WORD_MASK  (BITBOARD_WORD_BITS - 1)
+#define BITBOARD_ONE        ((uint64_t) 1)
+#define BITBOARD_ALL        (~((uint64_t) 0))
+#define BITBOARD_INIT_DIRTY_CAPACITY 16
+
+/* Threat Mask (cells in the enemy line of fire) */
+#define THREAT_INIT_TILE_CAPACITY 4
+
+/* Trace memo */
+#define TRACE_INIT_MEMO_CAPACITY 64
+
+/* Enemies and spatial hashes (power of 2) */
+#define ENEMY_INIT_CAPACITY     4
+#define CELL_HASH_INIT_CAPACITY 64
+#define THREAT_INIT_ENTRY_CAPACITY 64
+#define THREAT_INIT_FIRE_CAPACITY  16
+
+/* Splitmix64 (random numbers and hash keys, 64-bit constants from two 32-bit halves) */
+#define SPLITMIX_WORD(hi, lo) (((uint64_t) (hi) << 32) | (uint64_t) (lo))
+#define SPLITMIX_GOLDEN       SPLITMIX_WORD(0x9E3779B9UL, 0x7F4A7C15UL)
+#define SPLITMIX_MIX_1        SPLITMIX_WORD(0xBF58476DUL, 0x1CE4E5B9UL)
+#define SPLITMIX_MIX_2        SPLITMIX_WORD(0x94D049BBUL, 0x133111EBUL)
+#define RNG_UNIT_SCALE        (1.0 / 9007199254740992.0)	/* 2^-53 */
+
+/* Zobrist keys */
+#define ZOBRIST_PLAYER       0	/* key kinds */
+#define ZOBRIST_ENEMY        1
+#define ZOBRIST_LEVEL_ENEMY  2
+#define ZOBRIST_MIRROR       3
+#define ZOBRIST_BOARD        4
+#define ZOBRIST_KINDS        8
+
+/* Transposition table (power of 2 slots, fixed) */
+#define TRANS_TABLE_PROBES   4	/* slots probed per key */
+
+/* Bullets in flight */
+#define BULLET_INIT_CAPACITY 8
+#define INPUT_QUEUE_CAPACITY 64
+
+/* Batch stepping: lines of fire shared by the instances */
+#define BATCH_INIT_ENTRY_CAPACITY 64
+
+/* Observation bit-planes (one bit per cell, row-major, planeWords words each) */
+#define PLANE_WALL      0
+#define PLANE_FMIRROR   1
+#define PLANE_BMIRROR   2
+#define PLANE_PLAYER    3	/* + direction index (up, down, left, right) */
+#define PLANE_ENEMY     7	/* + direction index (up, down, left, right) */
+#define PLANE_BULLET    11
+#define PLANE_COUNT     12
+
+/* Tools (batch runner, ...) */
+#define TOOL_MAX_LINE     1024	/* manifest line */
+#define BATCH_LEVEL_CACHE 4		/* loaded levels kept by each worker */
+#define BATCH_MANIFEST_SEPARATORS " \t\r\n"	/* between the level and the script names */
+
+/* Solver (BFS over the player states, one stage per set of enemies alive) */
+#define SOLVER_MAX_STAGES   256
+#define SOLVER_MAX_ENEMIES  64	/* one bit per enemy in the alive mask */
+#define SOLVER_PARENT_SHIFT 4	/* parents: 16 states of 4 bits per word */
+#define SOLVER_PARENT_MASK  ((1 << SOLVER_PARENT_SHIFT) - 1)
+#define SOLVER_PARENT_TURN  1	/* turned, + previous direction index */
+#define SOLVER_PARENT_STEP  5	/* moved one cell */
+#define SOLVER_PARENT_SHOT  6	/* destroyed an enemy */
+#define SOLVER_PARENT_START 7
+
+/* Danger map (flags of each cell, heatmap and overlay markers) */
+#define DANGER_KILL_SHIFT    0	/* + facing index: a shot from the cell destroys an enemy */
+#define DANGER_SELF_SHIFT    4	/* + facing index: a shot from the cell comes back */
+#define DANGER_THREAT        (1 << 8)	/* moving there draws enemy fire */
+#define DANGER_EMPTY         (1 << 9)
+#define DANGER_ROWS_PER_TASK 16
+#define DANGER_INIT_PATH_CAPACITY 64
+#define DANGER_MARKER_THREAT 'X'
+#define DANGER_MARKER_KILL   '+'
+#define DANGER_MARKER_NONE   '.'
+
+/* Level generator */
+#define GEN_MIN_SIZE         4		/* rows and columns, border included */
+#define GEN_MAX_DENSITY      0.5	/* mirrors per interior cell */
+#define GEN_MAX_CANDIDATES   1000	/* candidates per level before giving up */
+#define GEN_MAX_PLAYER_TRIES 64		/* player cells tried per candidate */
+#define GEN_FILE_FORMAT      "%s/level_%06d.txt"
+
+/* Win-rate estimator (random games of each level) */
+#define RATE_ACTIONS           5	/* the four move keys and the shot */
+#define RATE_ROLLOUTS_PER_TASK 256	/* games per block handed to a thread */
+#define RATE_DEFAULT_ROLLOUTS  10000
+#define RATE_DEFAULT_MAX_TURNS 500
+#define RATE_POLICY_RANDOM     0
+#define RATE_POLICY_SAFE       1
+#define RATE_Z_95              1.959964	/* normal quantile of a 95% interval */
+#define RATE_SAFE_TABLE_SIZE   (1 << 16)	/* safe moves cached per thread (power of 2) */
+
+/* Agents and tournament (every agent on every level) */
+#define AGENT_ACTIONS             5		/* the four move keys and the shot */
+#define TOURNEY_MAX_AGENTS        16
+#define TOURNEY_DEFAULT_MAX_TURNS 1000
+#define TOURNEY_DEFAULT_BUDGET_MS 1000.0	/* agent decision time per match */
+
+/* Core checks (make test): random actions, the episodes restart when over */
+#define CHECK_INSTANCES     64
+#define CHECK_ACTIONS       6	/* moves, shot and a wait */
+#define CHECK_DEFAULT_STEPS 2000
+#define CHECK_PLANES_PERIOD 8	/* steps between two plane encodings, on average */
+#define CHECK_MAX_REPORTS   20	/* mismatches printed */
+
+/* Event loop (frame tick of 0.2 s) */
+#define TICK_INTERVAL_NS      200000000L
+#define EVENT_LOOP_MAX_EVENTS 4
 
 /* Direction */
 #define DIR_LEFT    'l'
@@ -29,15 +156,43 @@
 #define KEY_DOWN    's'
 #define KEY_SHOOT   'f'
 #define KEY_LOG     'l'
+#define KEY_SKIP    'k'
+#define KEY_LINE_END '\n'	/* ends a batch of keys (queued, never applied) */
 
 /* Game status */
-typedef enum {PLAYER_HIT, ENEMY_HIT, PROGRESSING, SAVE_ERROR} GameStatus;
+typedef enum {PLAYER_HIT, ENEMY_HIT, PROGRESSING, SAVE_ERROR, INPUT_CLOSED} GameStatus;
+
+/* Script mode exit codes */
+#define EXIT_WON          0
+#define EXIT_LOST         1
+#define EXIT_SAVE_ERROR   2
+#define EXIT_INPUT_CLOSED 3
+#define EXIT_INIT_ERROR   4
+
+/* Level load errors (refer loadErrorMessage()) */
+#define LOAD_OK               0
+#define LOAD_FILE_ERROR       1
+#define LOAD_FORMAT_ERROR     2
+#define LOAD_PLAYER_BOUNDS    3
+#define LOAD_ENEMY_BOUNDS     4
+#define LOAD_TANK_OVERLAP     5
+#define LOAD_ENEMY_OVERLAP    6
+#define LOAD_ENEMY_ON_MIRROR  7
+#define LOAD_INSTANT_LOSE     8
+#define LOAD_MIRROR_BOUNDS    9
+#define LOAD_MIRROR_ON_PLAYER 10
+#define LOAD_MIRROR_ON_ENEMY  11
 
 /* Terminal Colors */
 #define LIGHT_GREEN "\033[38;5;0;48;5;194m"
 #define BRIGHT_RED  "\033[48;5;1m"
 #define CLEAN       "\033[0m"
 
+/* Raw Mode Screen (map drawn over the previous one, menu as a footer) */
+#define CURSOR_HOME       "\033[H"
+#define CURSOR_ROW_ERASE  "\033[%d;1H\033[J"	/* move to a row, erase below */
+#define MENU_ROWS         7
+
 
 
 #endif
\ No newline at end of file
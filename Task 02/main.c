@@ -15,8 +15,79 @@
 #include "macros.h"
 #include "envinit.h"
 #include "gameops.h"
+#include "render.h"
 #include "linkedlist.h"
+#include "threat.h"
+#include "enemy.h"
+#include "bullet.h"
+#include "terminal.h"
 
+/**************************************************************************************************/
+/* Command Line Methods													    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Parse command line arguments and export the necessary variables.
+ * Optional flags follow the file names:
+ *   -m  enemy banks shots off the mirrors.
+ *   -s  shots are resolved without the animation.
+ *   -a  show the shot frames even if stdout is not a terminal.
+ *   -x  script mode: the moves are read from stdin (file or pipe) at full
+ *       speed, nothing is shown and the exit code is the outcome.
+ * 
+ * @param argc command line args count.
+ * @param argv command line args strings.
+ * @param pzConfigFileName export variable for configuration file name (input file).
+ * @param pLogFile export variable for log file object - output file (struct FileEx).
+ * @param pOptions export variable for the optional game options.
+ * @return int success status.
+ */
+static int parseCmdArgs(int argc, char** argv, const char** pzConfigFileName, FileEx* pLogFile,
+																GameOptions* pOptions)
+{
+	int i, success = (argc >= 3);
+
+	pOptions->isMirrorFire = FALSE;
+	pOptions->isSkipAnimation = FALSE;
+	pOptions->isScript = FALSE;
+	pOptions->isAllFrames = FALSE;
+
+	for (i = 3; success && i < argc; i++)
+	{
+		if (strcmp(argv[i], "-m") == 0)
+			pOptions->isMirrorFire = TRUE;
+		else if (strcmp(argv[i], "-s") == 0)
+			pOptions->isSkipAnimation = TRUE;
+		else if (strcmp(argv[i], "-a") == 0)
+			pOptions->isAllFrames = TRUE;
+		else if (strcmp(argv[i], "-x") == 0)
+			pOptions->isScript = pOptions->isSkipAnimation = TRUE;
+		else
+			success = FALSE;
+	}
+
+	if (!success)
+	{
+		printf("Correct Usage:\n");
+        printf("%s <input_filename> <output_filename> [-m] [-s] [-a] [-x]\n", argv[0]);
+        printf("  -m  enemy banks shots off the mirrors\n");
+        printf("  -s  skip the shot animation\n");
+        printf("  -a  show the shot frames when stdout is not a terminal\n");
+        printf("  -x  script mode, moves from stdin, exit code 0 won, 1 lost,\n");
+        printf("      2 save error, 3 moves ended before the game\n");
+	}
+	else
+	{
+		*pzConfigFileName = argv[1];
+		pLogFile->fptr = NULL;
+		pLogFile->zFileName = argv[2];
+	}	
+	
+	return success;
+}
+
+/**************************************************************************************************/
+/* Main																    	      		  	  */
+/**************************************************************************************************/
 int main(int argc, char *argv[])
 {
 	/* Declrations: Convient Parameter Passing */
@@ -28,20 +99,34 @@ int main(int argc, char *argv[])
 		
 	/* Declrations: Map Related */
 	MapInfo* pMapInfo = NULL;
-	GameObj player, enemy;
+	GameObj player;
+	EnemySet* pEnemies = NULL;
 		
 	/* Declrations: Game related */	
 	const char* zConfigFileName;
 	FileEx logFile;
+	GameOptions options;
+	GameStatus gameStatus;
+	int exitCode = 0;
+	int loadError = LOAD_OK;
 
     /* Initialize the game */
-    if (parseCmdArgs(argc, argv, &zConfigFileName, &logFile) &&
-		initGame(zConfigFileName, &pMapInfo, &player, &enemy, &pMirrorList, &pLogList))
+    if (parseCmdArgs(argc, argv, &zConfigFileName, &logFile, &options) &&
+		initGame(zConfigFileName, &pMapInfo, &pEnemies, &player, &pMirrorList, &pLogList,
+																				&loadError))
 	/*if (initGame(&map, aiMapSize, aiEnemy, aiPlayer, argv, argc))*/
 	{
         /* pack the individual params to RefreshPrams object */
-		packRefreshParams(&oRP, pMapInfo, &enemy, &player, NULL, 
+		packRefreshParams(&oRP, pMapInfo, pEnemies, &player, createBulletPool(), 
                                     pMirrorList, pLogList, &logFile, TRUE);
+		oRP.isHeadless = options.isScript;
+
+		/* Output to a pipe or a file: lean frames, the shot outcome only (unless -a) */
+		oRP.isLean = !isTerminalOutput();
+		options.isSkipAnimation = options.isSkipAnimation || (oRP.isLean && !options.isAllFrames);
+
+		/* Enemy lines of fire, computed on the first move */
+		oRP.pThreat = createThreatMask(pMapInfo, pEnemies, options.isMirrorFire);
 
         /* RP debug print Print */
         debugRefreshMapParams(&oRP, "RP");
@@ -50,11 +135,32 @@ int main(int argc, char *argv[])
 		refreshMap(&oRP);
 
         /* Enter into the main loop and process the game status once loop exits */
-		processGameStatus(mainLoop(&oRP));
+		gameStatus = mainLoop(&oRP, &options);
+		processGameStatus(gameStatus, oRP.isLean);
+
+		/* Script mode: the outcome is the exit code */
+		if (options.isScript)
+			exitCode = getExitCode(gameStatus);
 
         /* Exit from the game, cleanup ! */
-		exitGame(pMapInfo, pMirrorList, pLogList);
+		destroyThreatMask(oRP.pThreat);
+		destroyBulletPool(oRP.pBullets);
+		exitGame(pMapInfo, pEnemies, pMirrorList, pLogList);
     }
+	else
+	{
+		/* The loader does not print, report why the level was rejected */
+		if (loadError != LOAD_OK)
+		{
+			printErrorEx(loadErrorMessage(loadError), !isTerminalOutput());
+			if (loadError == LOAD_FILE_ERROR)
+				printf(": %s", zConfigFileName);
+			printf("\n");
+		}
+
+		if (options.isScript)
+			exitCode = EXIT_INIT_ERROR;
+	}
 
-    return 0;
+    return exitCode;
 }
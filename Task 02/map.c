@@ -13,32 +13,205 @@
 #include "map.h"
 #include "util.h"
 #include "macros.h"
-#include "newSleep.h"
+#include "bitboard.h"
+#include "enemy.h"
+#include "cellhash.h"
 
-typedef void (*Colours)(char);
+/**************************************************************************************************/
+/* Map Tile Related Methods												    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief The cell of an empty map (border or empty). Implicit (not materialised)
+ * tiles are made of these cells.
+ * 
+ * @param pMapInfo map object.
+ * @param row row index of the map.
+ * @param col column index of the map.
+ * @return char border or empty marker.
+ */
+static char blankCell(const MapInfo* pMapInfo, int row, int col)
+{
+	int isBorder = (row == 0 || row == pMapInfo->rows - 1 || 
+					col == 0 || col == pMapInfo->cols - 1);
+
+	return isBorder ? MARKER_BORDER : MARKER_EMPTY;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief The materialised tile, looked up in the sparse index of a snapshot
+ * or in the tile directory.
+ * 
+ * @param pMapInfo map object.
+ * @param tileIdx index of the tile in the tile directory.
+ * @return MapTile* the tile, NULL if implicit.
+ */
+static MapTile* findTile(const MapInfo* pMapInfo, int tileIdx)
+{
+	MapTile* pTile = NULL;
+
+	if (pMapInfo->apTiles)
+	{
+		pTile = pMapInfo->apTiles[tileIdx];
+	}
+	else
+	{
+		int slot = lookupCellHash(pMapInfo->pSparseIndex, tileIdx, -1);
+		pTile = (slot != -1) ? &(pMapInfo->aSparseTiles[slot]) : NULL;
+	}
+
+	return pTile;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Fill the tile with the cells of an empty map (border and empty cells).
+ * 
+ * @param pMapInfo map object.
+ * @param pTile tile to fill.
+ * @param tileIdx index of the tile in the tile directory.
+ */
+static void fillBlankTile(const MapInfo* pMapInfo, MapTile* pTile, int tileIdx)
+{
+	int i, j;
+	int stRow = (tileIdx / pMapInfo->tileCols) << MAP_TILE_SHIFT;
+	int stCol = (tileIdx % pMapInfo->tileCols) << MAP_TILE_SHIFT;
+
+	/* PERF: Only the tiles on the edge of the map can hold border cells */
+	int isEdgeTile = (stRow == 0 || stCol == 0 || 
+						stRow + MAP_TILE_SIZE >= pMapInfo->rows || 
+						stCol + MAP_TILE_SIZE >= pMapInfo->cols);
+
+	memset(pTile->aCells, MARKER_EMPTY, MAP_TILE_CELLS);
+
+	if (pTile->aColCells)
+		memset(pTile->aColCells, MARKER_EMPTY, MAP_TILE_CELLS);
+
+	for (i = stRow; isEdgeTile && i < stRow + MAP_TILE_SIZE && i < pMapInfo->rows; i++)
+	{
+		for (j = stCol; j < stCol + MAP_TILE_SIZE && j < pMapInfo->cols; j++)
+		{
+			pTile->aCells[MAP_CELL_OFFSET(i, j)] = blankCell(pMapInfo, i, j);
+
+			if (pTile->aColCells)
+				pTile->aColCells[MAP_CELL_OFFSET(j, i)] = blankCell(pMapInfo, i, j);
+		}
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Double the capacity of the used/free tile bookkeeping arrays.
+ * 
+ * @param pMapInfo map object.
+ */
+static void growTileStore(MapInfo* pMapInfo)
+{
+	pMapInfo->tileCapacity *= 2;
+	pMapInfo->aiUsedTiles = (int*) realloc(pMapInfo->aiUsedTiles, 
+										sizeof(int) * pMapInfo->tileCapacity);
+	pMapInfo->apFreeTiles = (MapTile**) realloc(pMapInfo->apFreeTiles, 
+										sizeof(MapTile*) * pMapInfo->tileCapacity);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Materialise an implicit tile. Released tiles are reused before 
+ * allocating (malloc()) a new one.
+ * 
+ * @param pMapInfo map object.
+ * @param tileIdx index of the tile in the tile directory.
+ * @return MapTile* materialised tile filled with the empty map cells.
+ */
+static MapTile* materialiseTile(MapInfo* pMapInfo, int tileIdx)
+{
+	MapTile* pTile = NULL;
+
+	if (pMapInfo->nFreeTiles > 0)
+	{
+		pTile = pMapInfo->apFreeTiles[--(pMapInfo->nFreeTiles)];
+	}
+	else
+	{
+		if (pMapInfo->nUsedTiles == pMapInfo->tileCapacity)
+			growTileStore(pMapInfo);
+
+		pTile = (MapTile*) malloc(sizeof(MapTile));
+		pTile->aColCells = pMapInfo->isColumnShadow ? (char*) malloc(MAP_TILE_CELLS) : NULL;
+	}
+
+	fillBlankTile(pMapInfo, pTile, tileIdx);
+	pMapInfo->apTiles[tileIdx] = pTile;
+	pMapInfo->aiUsedTiles[pMapInfo->nUsedTiles++] = tileIdx;
+
+	return pTile;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Free the tile and its column-major shadow. Call free().
+ * 
+ * @param pTile the tile.
+ */
+static void freeTile(MapTile* pTile)
+{
+	free(pTile->aColCells);
+	free(pTile);
+}
 
 /**************************************************************************************************/
 /* Map Managment Methods												    		      		  */
 /**************************************************************************************************/
 /**
- * @brief Create a Map object
+ * @brief Create a Map object without the bitboard fast path. The map is stored
+ * as tiles, only the tile directory is allocated here. Empty tiles are implicit.
  * 
  * @param rows map/canvas number of rows.
  * @param cols map/canvas number of columns.
  * @return MapInfo* map object.
  */
-MapInfo* createMap(int rows, int cols)
+static MapInfo* createTiledMap(int rows, int cols)
 {
-	int i;
-	
 	MapInfo* pMapInfo = (MapInfo*) malloc(sizeof(MapInfo));
-	pMapInfo->map = (char**) malloc(sizeof(char*) * rows);
-		
-	for (i = 0; i < rows ; i++)	
-		pMapInfo->map[i] = (char*) malloc(sizeof(char) * cols);
 	
 	pMapInfo->rows = rows;
 	pMapInfo->cols = cols;
+	pMapInfo->tileRows = (rows + MAP_TILE_MASK) >> MAP_TILE_SHIFT;
+	pMapInfo->tileCols = (cols + MAP_TILE_MASK) >> MAP_TILE_SHIFT;
+	pMapInfo->apTiles = (MapTile**) calloc((size_t) pMapInfo->tileRows * pMapInfo->tileCols, 
+																		sizeof(MapTile*));
+	pMapInfo->tileCapacity = MAP_INIT_TILE_CAPACITY;
+	pMapInfo->aiUsedTiles = (int*) malloc(sizeof(int) * pMapInfo->tileCapacity);
+	pMapInfo->apFreeTiles = (MapTile**) malloc(sizeof(MapTile*) * pMapInfo->tileCapacity);
+	pMapInfo->nUsedTiles = 0;
+	pMapInfo->nFreeTiles = 0;
+	pMapInfo->pBitboard = NULL;
+	pMapInfo->isColumnShadow = FALSE;
+	pMapInfo->aSparseTiles = NULL;
+	pMapInfo->pSparseIndex = NULL;
+	selectScanKernels(&(pMapInfo->oScan));
+	
+	return pMapInfo;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Create a Map object. Maps up to BITBOARD_MAX_COLS columns wide also 
+ * keep a bitboard (occupancy bit sets) for fast obstacle search. Wider maps
+ * keep column-major shadows of the tiles instead, for vertical scans.
+ * 
+ * @param rows map/canvas number of rows.
+ * @param cols map/canvas number of columns.
+ * @return MapInfo* map object.
+ */
+MapInfo* createMap(int rows, int cols)
+{
+	MapInfo* pMapInfo = createTiledMap(rows, cols);
+	
+	if (cols <= BITBOARD_MAX_COLS)
+		pMapInfo->pBitboard = createBitboard(rows, cols);
+	else
+		pMapInfo->isColumnShadow = TRUE;
 	
 	return pMapInfo;
 }
@@ -52,12 +225,26 @@ MapInfo* createMap(int rows, int cols)
 void destroyMap(MapInfo* pMapInfo)
 {
 	int i;
-	for (i = 0; i < pMapInfo->rows ; i++)	
-		free(pMapInfo->map[i]);
+	for (i = 0; pMapInfo->apTiles && i < pMapInfo->nUsedTiles ; i++)	
+		freeTile(pMapInfo->apTiles[pMapInfo->aiUsedTiles[i]]);
+
+	for (i = 0; i < pMapInfo->nFreeTiles ; i++)	
+		freeTile(pMapInfo->apFreeTiles[i]);
+
+	if (pMapInfo->pSparseIndex)
+	{
+		destroyCellHash(pMapInfo->pSparseIndex);
+		free(pMapInfo->aSparseTiles);
+	}
 	
-	free(pMapInfo->map);
+	free(pMapInfo->apTiles);
+	free(pMapInfo->aiUsedTiles);
+	free(pMapInfo->apFreeTiles);
+
+	if (pMapInfo->pBitboard)
+		destroyBitboard(pMapInfo->pBitboard);
 		
-	pMapInfo->map = NULL;
+	pMapInfo->apTiles = NULL;
 	pMapInfo->rows = -1;
 	pMapInfo->cols = -1;
 	free(pMapInfo);
@@ -65,26 +252,26 @@ void destroyMap(MapInfo* pMapInfo)
 
 /**************************************************************************************************/
 /**
- * @brief Reset the map. place the border of the canvas.
+ * @brief Reset the map. Only the border remains on the canvas.
  * 
  * @param pMapInfo map object.
  */
 void resetMap(MapInfo* pMapInfo)
 {	
 	int i;
-	for (i = 0; i < pMapInfo->rows ; i++)
+
+	/* PERF: Release the materialised tiles only, the empty map (border) is implicit */
+	for (i = 0; i < pMapInfo->nUsedTiles ; i++)
 	{
-		if (i == 0 || i == pMapInfo->rows - 1)
-		{
-			memset(pMapInfo->map[i], MARKER_BORDER, pMapInfo->cols);
-		}
-		else
-		{
-			memset(pMapInfo->map[i], MARKER_BORDER, 1);
-			memset(pMapInfo->map[i] + 1, ' ', pMapInfo->cols - 2);
-			memset(pMapInfo->map[i] + pMapInfo->cols - 1, MARKER_BORDER, 1);
-		}
-	}	
+		int tileIdx = pMapInfo->aiUsedTiles[i];
+		pMapInfo->apFreeTiles[pMapInfo->nFreeTiles++] = pMapInfo->apTiles[tileIdx];
+		pMapInfo->apTiles[tileIdx] = NULL;
+	}
+
+	pMapInfo->nUsedTiles = 0;
+
+	if (pMapInfo->pBitboard)
+		resetBitboard(pMapInfo->pBitboard);
 }
 
 /**************************************************************************************************/
@@ -131,7 +318,7 @@ void placeObj(MapInfo* pMapInfo, GameObj* pObj)
 				break;
 		}
 		
-		pMapInfo->map[pObj->row][pObj->col] = face;
+		setCell(pMapInfo, pObj->row, pObj->col, face);
 	}
 }
 
@@ -157,179 +344,292 @@ void placeMirrors(MapInfo* pMapInfo, LinkedList* pMirrorList)
 	}
 }
 
+/**************************************************************************************************/
+/**
+ * @brief Place the live enemies with the correct face.
+ * 
+ * @param pMapInfo map object.
+ * @param pEnemies enemy set object.
+ */
+void placeEnemies(MapInfo* pMapInfo, const EnemySet* pEnemies)
+{
+	int i;
+	GameObj enemy;
+
+	if (pEnemies)
+	{
+		for (i = 0; i < pEnemies->nEnemies; i++)
+		{
+			if (pEnemies->aIsAlive[i])
+			{
+				getEnemy(pEnemies, i, &enemy);
+				placeObj(pMapInfo, &enemy);
+			}
+		}
+	}
+}
+
 /**************************************************************************************************/
 /**
  * @brief Creates a new map object (malloc()) and copy pMapInfo object to it. 
+ * The copy is a read-only snapshot (for logging, getCell() only): it does not
+ * keep the bitboard or the column-major shadows.
  * 
  * @param pMapInfo map object.
  * @return MapInfo* new map object.
  */
 MapInfo* copyMapInfo(const MapInfo* pMapInfo)
 {
-	int i ;
-	MapInfo* pMapInfoCopy = createMap(pMapInfo->rows, pMapInfo->cols);
-		
-	/* Take a copy of map */ 
-	for (i = 0 ; i < pMapInfo->rows ; i++)
+	int i, capacity = CELL_HASH_INIT_CAPACITY;
+	MapInfo* pMapInfoCopy = (MapInfo*) malloc(sizeof(MapInfo));
+
+	*pMapInfoCopy = *pMapInfo;
+	pMapInfoCopy->apTiles = NULL;
+	pMapInfoCopy->aiUsedTiles = NULL;
+	pMapInfoCopy->apFreeTiles = NULL;
+	pMapInfoCopy->nFreeTiles = 0;
+	pMapInfoCopy->tileCapacity = 0;
+	pMapInfoCopy->pBitboard = NULL;
+	pMapInfoCopy->isColumnShadow = FALSE;
+
+	/* PERF: Sparse copy, no tile directory: each logged frame costs its used tiles only */
+	while (capacity < 2 * pMapInfo->nUsedTiles)
+		capacity *= 2;
+
+	pMapInfoCopy->pSparseIndex = createCellHash(capacity);
+	pMapInfoCopy->aSparseTiles = (MapTile*) malloc(sizeof(MapTile) * (pMapInfo->nUsedTiles + 1));
+
+	for (i = 0 ; i < pMapInfo->nUsedTiles ; i++)
 	{
-		memcpy(pMapInfoCopy->map[i], pMapInfo->map[i], sizeof(char) * pMapInfo->cols);
+		int tileIdx = pMapInfo->aiUsedTiles[i];
+		MapTile* pTile = &(pMapInfoCopy->aSparseTiles[i]);
+
+		memcpy(pTile->aCells, pMapInfo->apTiles[tileIdx]->aCells, sizeof(pTile->aCells));
+		pTile->aColCells = NULL;
+		insertCellHash(pMapInfoCopy->pSparseIndex, tileIdx, i);
 	}
 	
 	return pMapInfoCopy;
 }
 
-/**************************************************************************************************/
-/* Map Display Methods												    		      		  	  */
 /**************************************************************************************************/
 /**
- * @brief Store the map object (the current canvas with all objects placed) in
- * a node in the linked list.
+ * @brief Reset the map and place all the objects (enemies, mirrors, player) 
+ * on it. Nothing is printed or stored.
  * 
  * @param pRP parameter object to pass across functions.
- * @param pMapInfo map object.
  */
-static void storeMap(RefreshMapParam* pRP, MapInfo* pMapInfo)
+void rebuildMap(RefreshMapParam* pRP)
 {
-	/* Declarations: linked list debug prints */
-	static int nodeCounter = 0;
-	char prefix[50];
-
-	NodeData* pNodeData = (NodeData*) malloc(sizeof(NodeData));
-	pNodeData->pMapInfo = copyMapInfo(pMapInfo);
-	pNodeData->pLogFile = pRP->pLogFile;
-
-	/* Insert to linked list */
-	insertLast(pRP->pLogList, pNodeData);
+	MapInfo* pMapInfo = pRP->pMapInfo;
 	
-	/* Debug print */		
-	nodeCounter++;		
-	sprintf(prefix, "Log: Insert_%2d", nodeCounter);
-	debugLinkedList(pRP->pLogList, prefix);
+	/* Reset map and set the border */
+	resetMap(pMapInfo);
+
+	/* Place the objects on the map */	
+	placeEnemies(pMapInfo, pRP->pEnemies);
+	placeMirrors(pMapInfo, pRP->pMirrorList);
+	placeObj(pMapInfo, pRP->pPlayer);
 }
 
+/**************************************************************************************************/
+/* Map Cell Accessors												    		      		  	  */
 /**************************************************************************************************/
 /**
- * @brief Print map (with all the other objects[enemy, player, bullet, mirrors]) 
- * to the terminal or file, and store the map in a linked list node.
+ * @brief Get the cell (marker) of the map. Cells of implicit tiles are empty
+ * or border cells, cells out of the map are treated as border cells.
  * 
- * @param i row index of the map.
- * @param j column index of the map.
- * @param pColors colors array (type function pointer).
  * @param pMapInfo map object.
- * @param pCfgFile configuration file - input file (FILE).
+ * @param row row index of the map.
+ * @param col column index of the map.
+ * @return char the cell.
  */
-static void printAndStoreMapExCore(int i, int j, Colours pColors[], MapInfo* pMapInfo, FILE* pCfgFile)
+char getCell(const MapInfo* pMapInfo, int row, int col)
 {
-	static int colourIdx = 0;
+	char cell = MARKER_BORDER;
+	
+	if (BETWEEN(0, pMapInfo->rows - 1, row) && BETWEEN(0, pMapInfo->cols - 1, col))
+	{
+		MapTile* pTile = findTile(pMapInfo, MAP_TILE_INDEX(pMapInfo, row, col));
 
-	if (pMapInfo->map[i][j] == '|' || pMapInfo->map[i][j] == '-')
-	{ 
-		if (pCfgFile)
-			fprintf(pCfgFile, "%c", pMapInfo->map[i][j]);
+		if (pTile)
+			cell = pTile->aCells[MAP_CELL_OFFSET(row, col)];
 		else
-		{
-			(*pColors[colourIdx++ % 2])(pMapInfo->map[i][j]);
-			colourIdx %= 2;
-		}
+			cell = blankCell(pMapInfo, row, col);
 	}
-	else
+
+	return cell;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Set the cell (marker) of the map. Materialises the tile if needed.
+ * Cells out of the map are ignored.
+ * 
+ * @param pMapInfo map object.
+ * @param row row index of the map.
+ * @param col column index of the map.
+ * @param cell the cell (marker).
+ */
+void setCell(MapInfo* pMapInfo, int row, int col, char cell)
+{
+	if (BETWEEN(0, pMapInfo->rows - 1, row) && BETWEEN(0, pMapInfo->cols - 1, col))
 	{
-		if (pCfgFile)
-			fprintf(pCfgFile, "%c", pMapInfo->map[i][j]);
-		else
-			printf("%c", pMapInfo->map[i][j]);
+		int tileIdx = MAP_TILE_INDEX(pMapInfo, row, col);
+		MapTile* pTile = pMapInfo->apTiles[tileIdx];
+
+		/* PERF: Writing an empty/border cell to an implicit tile is a no-op */
+		if (!pTile && cell != blankCell(pMapInfo, row, col))
+			pTile = materialiseTile(pMapInfo, tileIdx);
+
+		if (pTile)
+			pTile->aCells[MAP_CELL_OFFSET(row, col)] = cell;
+
+		if (pTile && pTile->aColCells)
+			pTile->aColCells[MAP_CELL_OFFSET(col, row)] = cell;
+
+		if (pMapInfo->pBitboard)
+			setBitboardCell(pMapInfo->pBitboard, row, col, cell != MARKER_EMPTY);
 	}
 }
 
+/**************************************************************************************************/
+/* Map Query Methods												    		      		  	  */
 /**************************************************************************************************/
 /**
- * @brief Print map (with all the other objects[enemy, player, bullet, mirrors]) 
- * to the terminal or file, and store the map in a linked list node.
+ * @brief Find the first non-empty cell of a span of an implicit (empty) tile. 
+ * Only the border cells can be non-empty.
  * 
- * @param pRP parameter object to pass across functions.
+ * @param pMapInfo map object.
+ * @param fixed the row index (horizontal) or the column index (vertical).
+ * @param lo first index of the span.
+ * @param hi last index of the span.
+ * @param isVertical whether the span is on a column.
+ * @param isForward whether to search from lo to hi or from hi to lo.
+ * @return int index of the cell. hi + 1 (forward) or lo - 1 (reverse) if none.
  */
-void printAndStoreMap(RefreshMapParam* pRP)
-{	
-	int i, j;
-	MapInfo* pMapInfo = pRP->pMapInfo;
-	FILE* pCfgFile = (pRP->pLogFile) ? pRP->pLogFile->fptr:NULL;
+static int scanBlankSpan(const MapInfo* pMapInfo, int fixed, int lo, int hi, 
+												int isVertical, int isForward)
+{
+	int found;
+	int limit = isVertical ? pMapInfo->rows : pMapInfo->cols;
+	int fixedLimit = isVertical ? pMapInfo->cols : pMapInfo->rows;
 
-	/* Cullet color change */
-    Colours aColors[2];
-    aColors[0] = &red;
-    aColors[1] = &green;
-	
-	for (i = 0 ; i < pMapInfo->rows ; i++)
-	{
-		for (j = 0 ; j < pMapInfo->cols ; j++)
-		{
-			printAndStoreMapExCore(i, j, aColors, pMapInfo, pCfgFile);
-		}
+	if (fixed == 0 || fixed == fixedLimit - 1)
+		found = isForward ? lo : hi;
+	else if (isForward)
+		found = (lo == 0) ? 0 : ((hi == limit - 1) ? hi : hi + 1);
+	else
+		found = (hi == limit - 1) ? hi : ((lo == 0) ? 0 : lo - 1);
 
-		if (pCfgFile)
-			fprintf(pRP->pLogFile->fptr, "\n");
-		else
-			printf("\n");
-	}
-	
-	if (pRP->isStoreMap)
-		storeMap(pRP, pMapInfo);	
+	return found;
 }
 
 /**************************************************************************************************/
 /**
- * @brief Refresh the map. This used to print the map to the screen or file
- * every time a user activity is performed.
+ * @brief Find the first non-empty cell of a span that lies in a single tile.
  * 
- * @param pRP parameter object to pass across functions.
+ * @param pMapInfo map object.
+ * @param fixed the row index (horizontal) or the column index (vertical).
+ * @param lo first index of the span.
+ * @param hi last index of the span.
+ * @param isVertical whether the span is on a column.
+ * @param isForward whether to search from lo to hi or from hi to lo.
+ * @return int index of the cell. hi + 1 (forward) or lo - 1 (reverse) if none.
  */
-void refreshMap(RefreshMapParam* pRP)
+static int scanTileSpan(const MapInfo* pMapInfo, int fixed, int lo, int hi, 
+												int isVertical, int isForward)
 {
-	refreshMapEx(pRP, TRUE);
+	int found, n = hi - lo + 1;
+	int row = isVertical ? lo : fixed, col = isVertical ? fixed : lo;
+	MapTile* pTile = pMapInfo->apTiles[MAP_TILE_INDEX(pMapInfo, row, col)];
+	const ScanKernels* pScan = &(pMapInfo->oScan);
+
+	if (!pTile)
+	{
+		found = scanBlankSpan(pMapInfo, fixed, lo, hi, isVertical, isForward);
+	}
+	else
+	{
+		const char* pFirst = pTile->aCells + MAP_CELL_OFFSET(row, col);
+		int isStrided = isVertical && !pTile->aColCells;
+
+		/* PERF: A column is contiguous in the column-major shadow */
+		if (isVertical && pTile->aColCells)
+			pFirst = pTile->aColCells + MAP_CELL_OFFSET(col, row);
+
+		/* PERF: SIMD kernels, cells of a column are MAP_TILE_SIZE apart without a shadow */
+		if (isStrided)
+			found = lo + (isForward ? (*pScan->pColumnForward)(pFirst, n, MAP_TILE_SIZE) 
+									: (*pScan->pColumnReverse)(pFirst, n, MAP_TILE_SIZE));
+		else
+			found = lo + (isForward ? (*pScan->pRowForward)(pFirst, n) 
+									: (*pScan->pRowReverse)(pFirst, n));
+	}
+
+	return found;
 }
 
+/**************************************************************************************************/
 /**
- * @brief Refresh the map. This used to print the map to the screen or file
- * every time a user activity is performed.
+ * @brief Find the first non-empty cell starting from idx inclusive along a 
+ * row or a column, one tile span at a time.
  * 
- * @param pRP parameter object to pass across functions.
- * @param isPrintAndStoreMap whether to print and store map or just place the
- * objects on the map/canvas.
+ * @param pMapInfo map object.
+ * @param fixed the row index (horizontal) or the column index (vertical).
+ * @param idx start index along the row/column.
+ * @param isVertical whether to search along a column.
+ * @param isForward whether to search towards the higher indices.
+ * @return int index of the cell. The index just out of the map if none.
  */
-void refreshMapEx(RefreshMapParam* pRP, int isPrintAndStoreMap)
-{	
-	MapInfo* pMapInfo = pRP->pMapInfo;
-	
-	/* Reset map and set the border */
-	resetMap(pMapInfo);
+static int scanLine(const MapInfo* pMapInfo, int fixed, int idx, int isVertical, int isForward)
+{
+	int limit = isVertical ? pMapInfo->rows : pMapInfo->cols;
+	int isFound = FALSE;
 
-	/* Place the objects on the map */	
-	placeObj(pMapInfo, pRP->pEnemy);
-	placeMirrors(pMapInfo, pRP->pMirrorList);
-	placeObj(pMapInfo, pRP->pPlayer);
-	placeObj(pMapInfo, pRP->pBullet);
-	
-	/* Print the Map */
-	if (isPrintAndStoreMap) 
+	while (!isFound && BETWEEN(0, limit - 1, idx))
 	{
-#ifndef DEBUG
-		system("clear");  /* <= comment this line if you want to see all past frames on terminal */
-#endif
-		printAndStoreMap(pRP);
+		int tileLo = idx & ~MAP_TILE_MASK;
+		int tileHi = (tileLo + MAP_TILE_MASK < limit - 1) ? tileLo + MAP_TILE_MASK : limit - 1;
+		int lo = isForward ? idx : tileLo;
+		int hi = isForward ? tileHi : idx;
+		int found = scanTileSpan(pMapInfo, fixed, lo, hi, isVertical, isForward);
+
+		isFound = BETWEEN(lo, hi, found);
+		idx = isFound ? found : (isForward ? hi + 1 : lo - 1);
 	}
-	
-	pRP->isStoreMap = FALSE;
+
+	return idx;
 }
 
 /**************************************************************************************************/
 /**
- * @brief Add pause time before refresh the map / screen. Refer refreshMap() for
- * more details.
+ * @brief Find the first non-empty cell (obstacle) starting from (row, col) 
+ * inclusive, moving towards the direction.
  * 
- * @param pRP parameter object to pass across functions.
+ * @param pMapInfo map object.
+ * @param row row index of the start cell.
+ * @param col column index of the start cell.
+ * @param direction direction to move.
+ * @return int row index (up/down) or column index (left/right) of the obstacle.
+ * The index just out of the map if none.
  */
-void pauseAndRefreshMap(RefreshMapParam* pRP)
+int findObstacle(const MapInfo* pMapInfo, int row, int col, char direction)
 {
-	newSleep(0.2);
-	refreshMap(pRP);
+	int isVertical = (direction == DIR_UP || direction == DIR_DOWN);
+	int isForward = (direction == DIR_DOWN || direction == DIR_RIGHT);
+	int idx = isVertical ? row : col;
+	int isInside = BETWEEN(0, pMapInfo->rows - 1, row) && BETWEEN(0, pMapInfo->cols - 1, col);
+
+	if (isInside && pMapInfo->pBitboard)
+	{
+		/* PERF: count trailing/leading zeros on the occupancy bit sets */
+		idx = findBitboardObstacle(pMapInfo->pBitboard, row, col, direction);
+	}
+	else if (isInside)
+	{
+		idx = scanLine(pMapInfo, isVertical ? col : row, idx, isVertical, isForward);
+	}
+
+	return idx;
 }
@@ -2,11 +2,31 @@
 #define MAP_H
 
 #include "linkedlist.h"
+#include "macros.h"
+#include "scan.h"
 
 /* Object Definitions */
+typedef struct MapTile
+{
+	char aCells[MAP_TILE_CELLS];
+	char* aColCells;		/* column-major shadow of aCells, NULL if the map has no shadow */
+} MapTile;
+
 typedef struct MapInfo
 {
-	char** map;
+	MapTile** apTiles;		/* tile directory, NULL entries are implicit empty tiles */
+	int* aiUsedTiles;		/* indices of the materialised tiles */
+	int nUsedTiles;
+	MapTile** apFreeTiles;	/* released tiles, kept for reuse */
+	int nFreeTiles;
+	int tileCapacity;
+	int tileRows;
+	int tileCols;
+	struct Bitboard* pBitboard;	/* occupancy fast path, NULL if wider than BITBOARD_MAX_COLS */
+	ScanKernels oScan;			/* SIMD scanning kernels selected at runtime */
+	int isColumnShadow;			/* keep column-major shadows of the tiles (vertical scans) */
+	MapTile* aSparseTiles;		/* snapshot (no tile directory): copies of the used tiles */
+	struct CellHash* pSparseIndex;	/* snapshot: tile index -> copy in aSparseTiles */
 	int rows;
 	int cols;
 	
@@ -25,16 +45,29 @@ typedef struct FileEx
 	const char* zFileName;	
 } FileEx;
 
+typedef struct GameOptions
+{
+	int isMirrorFire;	/* enemy banks shots off the mirrors (-m) */
+	int isSkipAnimation;	/* shots are resolved without the animation (-s) */
+	int isScript;		/* moves from stdin, nothing is shown, exit code is the outcome (-x) */
+	int isAllFrames;	/* show the shot frames when stdout is not a terminal (-a) */
+} GameOptions;
+
 typedef struct RefreshMapParam
 {
 	MapInfo* pMapInfo;
 	GameObj* pPlayer;
-	GameObj*	pEnemy;
-	GameObj* pBullet;
+	struct EnemySet* pEnemies;	/* enemy tanks */
+	struct BulletPool* pBullets;	/* bullets in flight, NULL if not tracked */
 	LinkedList* pMirrorList;
 	LinkedList* pLogList;
 	int isStoreMap;
 	FileEx* pLogFile;	
+	struct ThreatMask* pThreat;	/* enemy line of fire, NULL if not tracked */
+	struct ZobristHash* pZobrist;	/* state hash, NULL if not tracked */
+	struct Terminal* pTerminal;	/* raw mode terminal, NULL if not a terminal */
+	int isHeadless;				/* maps are logged, never printed (script mode) */
+	int isLean;					/* stdout is not a terminal: no colors, no clears */
 } RefreshMapParam;
 
 typedef struct NodeData
@@ -52,12 +85,15 @@ void destroyMap(MapInfo* pMapInfo);
 void resetMap(MapInfo* pMapInfo);
 void placeObj(MapInfo* pMapInfo, GameObj* pObj);
 void placeMirrors(MapInfo* pMapInfo, LinkedList* pMirrorList);
+void placeEnemies(MapInfo* pMapInfo, const struct EnemySet* pEnemies);
 MapInfo* copyMapInfo(const MapInfo* pMapInfo);
+void rebuildMap(RefreshMapParam* pRP);
+
+/* Map Cell Accessors */
+char getCell(const MapInfo* pMapInfo, int row, int col);
+void setCell(MapInfo* pMapInfo, int row, int col, char cell);
 
-/* Map Display Methods */
-void printAndStoreMap(RefreshMapParam* pRP);
-void refreshMap(RefreshMapParam* pRP);
-void refreshMapEx(RefreshMapParam* pRP, int isPrintAndStoreMap);
-void pauseAndRefreshMap(RefreshMapParam* pRP);
+/* Map Query Methods */
+int findObstacle(const MapInfo* pMapInfo, int row, int col, char direction);
 
 #endif
\ No newline at end of file
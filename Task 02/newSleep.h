@@ -1,6 +0,0 @@
-#ifndef NEWSLEEP_H
-#define NEWSLEEP_H
-
-    void newSleep(float sec);
-
-#endif
@@ -0,0 +1,291 @@
+/* PURPOSE: Observation encoder for agents: the board as fixed-size bit-planes
+ * (walls, mirrors, player and enemies by direction, bullets) written into a
+ * buffer of the caller. After the first observation only the cells that
+ * changed are written.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Local Includes */
+#include "planes.h"
+#include "enemy.h"
+#include "bullet.h"
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Plane offset of a direction (up, down, left, right).
+ *
+ * @param direction direction of the tank.
+ * @return int offset from PLANE_PLAYER / PLANE_ENEMY.
+ */
+static int directionPlane(char direction)
+{
+	return (direction == DIR_DOWN) + 2 * (direction == DIR_LEFT) + 3 * (direction == DIR_RIGHT);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Bit of the cell, counted from the start of the buffer.
+ *
+ * @param pEncoder plane encoder object.
+ * @param plane plane index (PLANE_*).
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ * @return long bit index.
+ */
+static long planeBit(const PlaneEncoder* pEncoder, int plane, int row, int col)
+{
+	return plane * pEncoder->planeWords * 64 + (long) row * pEncoder->cols + col;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Set or clear a bit of the buffer.
+ *
+ * @param aWords buffer of the planes.
+ * @param bit bit index.
+ * @param isSet whether to set the bit.
+ */
+static void writeBit(uint64_t* aWords, long bit, int isSet)
+{
+	uint64_t mask = (uint64_t) 1 << (bit & 63);
+
+	if (isSet)
+		aWords[bit >> 6] |= mask;
+	else
+		aWords[bit >> 6] &= ~mask;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Write the planes that never change: the border and the mirrors.
+ *
+ * @param pEncoder plane encoder object.
+ * @param pMirrorList mirror linked list.
+ * @param aWords buffer of the planes.
+ */
+static void encodeBoard(const PlaneEncoder* pEncoder, const LinkedList* pMirrorList, 
+																		uint64_t* aWords)
+{
+	int i;
+	LinkedListNode* pCur = pMirrorList ? pMirrorList->pHead : NULL;
+
+	for (i = 0; i < pEncoder->cols; i++)
+	{
+		writeBit(aWords, planeBit(pEncoder, PLANE_WALL, 0, i), TRUE);
+		writeBit(aWords, planeBit(pEncoder, PLANE_WALL, pEncoder->rows - 1, i), TRUE);
+	}
+
+	for (i = 0; i < pEncoder->rows; i++)
+	{
+		writeBit(aWords, planeBit(pEncoder, PLANE_WALL, i, 0), TRUE);
+		writeBit(aWords, planeBit(pEncoder, PLANE_WALL, i, pEncoder->cols - 1), TRUE);
+	}
+
+	while (pCur != NULL)
+	{
+		GameObj* pMirror = (GameObj*)(pCur->pData);
+		int plane = (pMirror->direction == DIR_F) ? PLANE_FMIRROR : PLANE_BMIRROR;
+
+		writeBit(aWords, planeBit(pEncoder, plane, pMirror->row, pMirror->col), TRUE);
+		pCur = pCur->pNext;
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Write the enemies that were destroyed (or are back, on a new episode)
+ * since the previous observation.
+ *
+ * @param pEncoder plane encoder object.
+ * @param pEnemies enemy set object.
+ * @param aWords buffer of the planes.
+ */
+static void encodeEnemies(PlaneEncoder* pEncoder, const EnemySet* pEnemies, uint64_t* aWords)
+{
+	int i;
+	GameObj enemy;
+
+	for (i = 0; i < pEnemies->nEnemies; i++)
+	{
+		if (pEnemies->aIsAlive[i] != pEncoder->aIsAlive[i])
+		{
+			getEnemy(pEnemies, i, &enemy);
+			writeBit(aWords, planeBit(pEncoder, PLANE_ENEMY + directionPlane(enemy.direction), 
+											enemy.row, enemy.col), pEnemies->aIsAlive[i]);
+			pEncoder->aIsAlive[i] = pEnemies->aIsAlive[i];
+		}
+	}
+
+	pEncoder->enemyGeneration = pEnemies->generation;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Write the bullets shown by the current tick, the ones shown before
+ * are cleared. The blows are not bullets. Past bulletCapacity bullets the
+ * next observation clears the whole bullet plane instead.
+ *
+ * @param pEncoder plane encoder object.
+ * @param pPool bullet pool object (can be NULL).
+ * @param aWords buffer of the planes.
+ */
+static void encodeBullets(PlaneEncoder* pEncoder, const BulletPool* pPool, uint64_t* aWords)
+{
+	int i;
+	long bit;
+
+	if (pEncoder->nBullets > pEncoder->bulletCapacity)
+	{
+		memset(aWords + PLANE_BULLET * pEncoder->planeWords, 0,
+										sizeof(uint64_t) * pEncoder->planeWords);
+	}
+	else
+	{
+		for (i = 0; i < pEncoder->nBullets; i++)
+			writeBit(aWords, pEncoder->alBullets[i], FALSE);
+	}
+
+	pEncoder->nBullets = 0;
+	for (i = 0; pPool && i < pPool->nOverlays; i++)
+	{
+		const GameObj* pOverlay = &(pPool->aOverlays[i]);
+
+		if (pOverlay->direction != 'X')
+		{
+			bit = planeBit(pEncoder, PLANE_BULLET, pOverlay->row, pOverlay->col);
+			writeBit(aWords, bit, TRUE);
+
+			if (pEncoder->nBullets < pEncoder->bulletCapacity)
+				pEncoder->alBullets[pEncoder->nBullets++] = bit;
+			else
+				pEncoder->nBullets = pEncoder->bulletCapacity + 1;
+		}
+	}
+}
+
+/**************************************************************************************************/
+/* Plane Encoder Managment Methods										    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Create a plane encoder object for the level. The buffer of the planes
+ * is PLANE_COUNT * planeWords words (uint64_t), owned by the caller.
+ *
+ * @param pMapInfo map object.
+ * @param pEnemies enemy set object.
+ * @param pPool bullet pool object (can be NULL), sizes the bullets remembered.
+ * @return PlaneEncoder* plane encoder object.
+ */
+PlaneEncoder* createPlaneEncoder(const MapInfo* pMapInfo, const EnemySet* pEnemies,
+									const BulletPool* pPool)
+{
+	PlaneEncoder* pEncoder = (PlaneEncoder*) malloc(sizeof(PlaneEncoder));
+
+	pEncoder->rows = pMapInfo->rows;
+	pEncoder->cols = pMapInfo->cols;
+	pEncoder->planeWords = ((long) pMapInfo->rows * pMapInfo->cols + 63) / 64;
+	pEncoder->nEnemies = pEnemies->nEnemies;
+	pEncoder->aIsAlive = (char*) malloc(sizeof(char) * (pEnemies->nEnemies + 1));
+	pEncoder->bulletCapacity = pPool ? pPool->overlayCapacity : BULLET_INIT_CAPACITY;
+	pEncoder->alBullets = (long*) malloc(sizeof(long) * pEncoder->bulletCapacity);
+	resetPlaneEncoder(pEncoder);
+
+	return pEncoder;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy the plane encoder object. Call free().
+ *
+ * @param pEncoder plane encoder object.
+ */
+void destroyPlaneEncoder(PlaneEncoder* pEncoder)
+{
+	free(pEncoder->aIsAlive);
+	free(pEncoder->alBullets);
+	free(pEncoder);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Forget the previous observation: the next one is written from scratch
+ * (a new buffer, or a buffer changed by the caller).
+ *
+ * @param pEncoder plane encoder object.
+ */
+void resetPlaneEncoder(PlaneEncoder* pEncoder)
+{
+	pEncoder->isEncoded = FALSE;
+	pEncoder->nBullets = 0;
+}
+
+/**************************************************************************************************/
+/* Plane Encoding Methods												    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Write the observation into the buffer. The first observation clears
+ * the buffer and writes every plane, the next ones only write the changes:
+ * the player, the enemies destroyed and the bullets. The buffer must still
+ * hold the previous observation of the same level. Nothing is allocated.
+ *
+ * @param pEncoder plane encoder object.
+ * @param pRP parameter object to pass across functions (game or tank core).
+ * @param aWords buffer of the planes (PLANE_COUNT * planeWords words).
+ */
+void encodePlanes(PlaneEncoder* pEncoder, const RefreshMapParam* pRP, uint64_t* aWords)
+{
+	GameObj* pPlayer = pRP->pPlayer;
+
+	if (!pEncoder->isEncoded)
+	{
+		memset(aWords, 0, sizeof(uint64_t) * PLANE_COUNT * pEncoder->planeWords);
+		memset(pEncoder->aIsAlive, FALSE, sizeof(char) * pEncoder->nEnemies);
+		encodeBoard(pEncoder, pRP->pMirrorList, aWords);
+		pEncoder->enemyGeneration = -1;
+	}
+	else if (pPlayer->row != pEncoder->oPlayer.row || pPlayer->col != pEncoder->oPlayer.col || 
+				pPlayer->direction != pEncoder->oPlayer.direction)
+	{
+		writeBit(aWords, planeBit(pEncoder, PLANE_PLAYER + directionPlane(pEncoder->oPlayer.direction), 
+									pEncoder->oPlayer.row, pEncoder->oPlayer.col), FALSE);
+	}
+
+	writeBit(aWords, planeBit(pEncoder, PLANE_PLAYER + directionPlane(pPlayer->direction), 
+															pPlayer->row, pPlayer->col), TRUE);
+	pEncoder->oPlayer = *pPlayer;
+
+	/* PERF: The enemies are looked at only when one was destroyed or revived */
+	if (pRP->pEnemies->generation != pEncoder->enemyGeneration)
+		encodeEnemies(pEncoder, pRP->pEnemies, aWords);
+
+	if (pEncoder->nBullets > 0 || (pRP->pBullets && pRP->pBullets->nOverlays > 0))
+		encodeBullets(pEncoder, pRP->pBullets, aWords);
+
+	pEncoder->isEncoded = TRUE;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Bit of a cell in a plane of the buffer.
+ *
+ * @param pEncoder plane encoder object.
+ * @param aWords buffer of the planes.
+ * @param plane plane index (PLANE_*).
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ * @return int TRUE if set.
+ */
+int getPlaneBit(const PlaneEncoder* pEncoder, const uint64_t* aWords, int plane, int row, int col)
+{
+	long bit = planeBit(pEncoder, plane, row, col);
+
+	return (int) ((aWords[bit >> 6] >> (bit & 63)) & 1);
+}
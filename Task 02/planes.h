@@ -0,0 +1,34 @@
+#ifndef PLANES_H
+#define PLANES_H
+
+#include <stdint.h>
+#include "map.h"
+#include "macros.h"
+
+/* Object Definitions */
+typedef struct PlaneEncoder
+{
+	int rows;
+	int cols;
+	long planeWords;		/* words of one plane, the buffer holds PLANE_COUNT planes */
+	int isEncoded;			/* the buffer holds the previous observation */
+	GameObj oPlayer;		/* previous observation: player */
+	char* aIsAlive;			/* previous observation: enemy flags */
+	int nEnemies;
+	long enemyGeneration;	/* previous observation: generation of the enemy set */
+	long* alBullets;		/* previous observation: bullet bits, fixed size */
+	int nBullets;			/* bulletCapacity + 1 if they did not fit */
+	int bulletCapacity;
+} PlaneEncoder;
+
+/* Plane Encoder Managment Methods */
+PlaneEncoder* createPlaneEncoder(const MapInfo* pMapInfo, const struct EnemySet* pEnemies,
+									const struct BulletPool* pPool);
+void destroyPlaneEncoder(PlaneEncoder* pEncoder);
+void resetPlaneEncoder(PlaneEncoder* pEncoder);
+
+/* Plane Encoding Methods */
+void encodePlanes(PlaneEncoder* pEncoder, const RefreshMapParam* pRP, uint64_t* aWords);
+int getPlaneBit(const PlaneEncoder* pEncoder, const uint64_t* aWords, int plane, int row, int col);
+
+#endif
@@ -0,0 +1,273 @@
+/* PURPOSE: Map display functionality (printing, logging and refreshing the
+ * map/canvas on the terminal).
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Local Includes */
+#include "render.h"
+#include "util.h"
+#include "macros.h"
+#include "bullet.h"
+#include "terminal.h"
+
+typedef void (*Colours)(char);
+
+/**************************************************************************************************/
+/* Map Display Methods												    		      		  	  */
+/**************************************************************************************************/
+/**
+ * @brief Store the map object (the current canvas with all objects placed) in
+ * a node in the linked list.
+ * 
+ * @param pRP parameter object to pass across functions.
+ * @param pMapInfo map object.
+ */
+static void storeMap(RefreshMapParam* pRP, MapInfo* pMapInfo)
+{
+	/* Declarations: linked list debug prints */
+	static int nodeCounter = 0;
+	char prefix[50];
+
+	NodeData* pNodeData = (NodeData*) malloc(sizeof(NodeData));
+	pNodeData->pMapInfo = copyMapInfo(pMapInfo);
+	pNodeData->pLogFile = pRP->pLogFile;
+
+	/* Insert to linked list */
+	insertLast(pRP->pLogList, pNodeData);
+	
+	/* Debug print */		
+	nodeCounter++;		
+	sprintf(prefix, "Log: Insert_%2d", nodeCounter);
+	debugLinkedList(pRP->pLogList, prefix);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Store the map in the log, along with the bullets in flight.
+ * 
+ * @param pRP parameter object to pass across functions.
+ */
+static void storeOverlaidMap(RefreshMapParam* pRP)
+{
+	if (pRP->pBullets)
+		placeOverlays(pRP->pMapInfo, pRP->pBullets);
+
+	storeMap(pRP, pRP->pMapInfo);
+
+	if (pRP->pBullets)
+		liftOverlays(pRP->pMapInfo, pRP->pBullets);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Print map (with all the other objects[enemy, player, bullet, mirrors]) 
+ * to the terminal or file, and store the map in a linked list node.
+ * 
+ * @param i row index of the map.
+ * @param j column index of the map.
+ * @param pColors colors array (type function pointer), NULL for no colors.
+ * @param pMapInfo map object.
+ * @param pCfgFile configuration file - input file (FILE).
+ */
+static void printAndStoreMapExCore(int i, int j, Colours pColors[], MapInfo* pMapInfo, FILE* pCfgFile)
+{
+	static int colourIdx = 0;
+	char cell = getCell(pMapInfo, i, j);
+
+	if ((cell == '|' || cell == '-') && pColors)
+	{ 
+		if (pCfgFile)
+			fprintf(pCfgFile, "%c", cell);
+		else
+		{
+			(*pColors[colourIdx++ % 2])(cell);
+			colourIdx %= 2;
+		}
+	}
+	else
+	{
+		if (pCfgFile)
+			fprintf(pCfgFile, "%c", cell);
+		else
+			printf("%c", cell);
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Print map (with all the other objects[enemy, player, bullet, mirrors]) 
+ * to the terminal or file, and store the map in a linked list node.
+ * 
+ * @param pRP parameter object to pass across functions.
+ */
+void printAndStoreMap(RefreshMapParam* pRP)
+{	
+	int i, j;
+	MapInfo* pMapInfo = pRP->pMapInfo;
+	FILE* pCfgFile = (pRP->pLogFile) ? pRP->pLogFile->fptr:NULL;
+
+	/* Cullet color change */
+    Colours aColors[2];
+    aColors[0] = &red;
+    aColors[1] = &green;
+	
+	for (i = 0 ; i < pMapInfo->rows ; i++)
+	{
+		for (j = 0 ; j < pMapInfo->cols ; j++)
+		{
+			printAndStoreMapExCore(i, j, pRP->isLean ? NULL : aColors, pMapInfo, pCfgFile);
+		}
+
+		if (pCfgFile)
+			fprintf(pRP->pLogFile->fptr, "\n");
+		else
+			printf("\n");
+	}
+	
+	if (pRP->isStoreMap)
+		storeMap(pRP, pMapInfo);	
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Refresh the map. This used to print the map to the screen or file
+ * every time a user activity is performed.
+ * 
+ * @param pRP parameter object to pass across functions.
+ */
+void refreshMap(RefreshMapParam* pRP)
+{
+	refreshMapEx(pRP, TRUE);
+}
+
+/**
+ * @brief Refresh the map. This used to print the map to the screen or file
+ * every time a user activity is performed.
+ * 
+ * @param pRP parameter object to pass across functions.
+ * @param isPrintAndStoreMap whether to print and store map or just place the
+ * objects on the map/canvas.
+ */
+void refreshMapEx(RefreshMapParam* pRP, int isPrintAndStoreMap)
+{	
+	MapInfo* pMapInfo = pRP->pMapInfo;
+	
+	/* Reset map and place the objects on it */
+	rebuildMap(pRP);
+	
+	/* Print the Map */
+	if (isPrintAndStoreMap && pRP->isHeadless)
+	{
+		if (pRP->isStoreMap)
+			storeOverlaidMap(pRP);
+	}
+	else if (isPrintAndStoreMap) 
+	{
+#ifndef DEBUG
+		/* PERF: In raw mode draw over the previous map, the footer stays */
+		if (pRP->pTerminal && pRP->pTerminal->isFooterShown)
+			printf(CURSOR_HOME);
+		else if (!pRP->isLean)
+			system("clear");  /* <= comment this line if you want to see all past frames on terminal */
+#endif
+		/* The bullets are shown, never collided with */
+		if (pRP->pBullets)
+			placeOverlays(pMapInfo, pRP->pBullets);
+
+		printAndStoreMap(pRP);
+
+		if (pRP->pBullets)
+			liftOverlays(pMapInfo, pRP->pBullets);
+
+#ifndef DEBUG
+		/* Messages go below the footer, until the next frame */
+		if (pRP->pTerminal && pRP->pTerminal->isFooterShown)
+			printf(CURSOR_ROW_ERASE, pRP->pTerminal->belowFooterRow);
+#endif
+	}
+	
+	pRP->isStoreMap = FALSE;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Refresh the map and store it in the log without printing it. Used to
+ * skip the shot animation, the log stays the same.
+ * 
+ * @param pRP parameter object to pass across functions.
+ */
+void storeRefreshedMap(RefreshMapParam* pRP)
+{
+	int isStoreMap = pRP->isStoreMap;
+
+	refreshMapEx(pRP, FALSE);
+
+	if (isStoreMap)
+		storeOverlaidMap(pRP);
+}
+
+/**************************************************************************************************/
+/* Color Related Methods														    	  		  */
+/**************************************************************************************************/
+/**
+ * @brief Put red color character on the terminal.
+ * 
+ * @param ch character to color.
+ */
+void red(char ch) 
+{
+    printf("\033[1;31m");
+    printf("%c%s", ch, "\033[0m");
+
+	return;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Put green color character on the terminal.
+ * 
+ * @param ch character to color.
+ */
+void green(char ch)
+{
+    printf("\033[1;32m");
+    printf("%c%s", ch, "\033[0m");
+
+	return;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Put red color string/error on the terminal.
+ * 
+ * @param zStr string to color.
+ */
+void printError(const char *zStr) 
+{
+    printErrorEx(zStr, FALSE);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Put a string/error on the terminal, red unless the output is lean
+ * (stdout is not a terminal, refer RefreshMapParam).
+ * 
+ * @param zStr string to print.
+ * @param isLean plain text, no color codes.
+ */
+void printErrorEx(const char *zStr, int isLean) 
+{
+	if (isLean)
+		printf("[ERROR] %s", zStr);
+	else
+	{
+		printf("\033[1;31m");
+		printf("[ERROR] %s%s", zStr, "\033[0m");
+	}
+}
@@ -0,0 +1,18 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include "map.h"
+
+/* Map Display Methods */
+void printAndStoreMap(RefreshMapParam* pRP);
+void refreshMap(RefreshMapParam* pRP);
+void refreshMapEx(RefreshMapParam* pRP, int isPrintAndStoreMap);
+void storeRefreshedMap(RefreshMapParam* pRP);
+
+/* Color Related */
+void red(char ch);
+void green(char ch);
+void printError(const char *zStr);
+void printErrorEx(const char *zStr, int isLean);
+
+#endif
@@ -0,0 +1,92 @@
+/* PURPOSE: Seeded pseudo random numbers (splitmix64) of the Tank Game tools.
+ * Each stream is independent and reproducible, so the work can be split
+ * between threads without changing the numbers drawn.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdlib.h>
+
+/* Local Includes */
+#include "rng.h"
+#include "macros.h"
+
+/**************************************************************************************************/
+/* Mixing Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Scramble the bits of a value (splitmix64 finalizer). Consecutive
+ * values give unrelated results.
+ *
+ * @param value value to mix.
+ * @return uint64_t mixed value.
+ */
+uint64_t mixBits(uint64_t value)
+{
+	uint64_t z = value;
+
+	z = (z ^ (z >> 30)) * SPLITMIX_MIX_1;
+	z = (z ^ (z >> 27)) * SPLITMIX_MIX_2;
+
+	return z ^ (z >> 31);
+}
+
+/**************************************************************************************************/
+/* Random Number Methods												    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Start a stream of random numbers.
+ *
+ * @param pRng random number generator object.
+ * @param seed seed shared by the streams of a run.
+ * @param stream stream index (level, game, thread, ...).
+ */
+void seedRng(Rng* pRng, uint64_t seed, uint64_t stream)
+{
+	pRng->state = mixBits(seed * SPLITMIX_GOLDEN + stream);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Next random number of the stream.
+ *
+ * @param pRng random number generator object.
+ * @return uint64_t 64 random bits.
+ */
+uint64_t nextRng(Rng* pRng)
+{
+	pRng->state += SPLITMIX_GOLDEN;
+
+	return mixBits(pRng->state);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Random integer in a range.
+ *
+ * @param pRng random number generator object.
+ * @param lo lowest value.
+ * @param hi highest value (inclusive, >= lo).
+ * @return int random integer in [lo, hi].
+ */
+int rangeRng(Rng* pRng, int lo, int hi)
+{
+	/* PERF: Multiply-shift instead of a division, the bias is below 2^-32 */
+	uint64_t span = (uint64_t) (hi - lo) + 1;
+
+	return lo + (int) (((nextRng(pRng) >> 32) * span) >> 32);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Random number in [0, 1).
+ *
+ * @param pRng random number generator object.
+ * @return double random number.
+ */
+double unitRng(Rng* pRng)
+{
+	return (double) (nextRng(pRng) >> 11) * RNG_UNIT_SCALE;
+}
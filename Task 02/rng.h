@@ -0,0 +1,21 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/* Object Definitions */
+typedef struct Rng
+{
+	uint64_t state;			/* splitmix64 counter */
+} Rng;
+
+/* Mixing Methods */
+uint64_t mixBits(uint64_t value);
+
+/* Random Number Methods */
+void seedRng(Rng* pRng, uint64_t seed, uint64_t stream);
+uint64_t nextRng(Rng* pRng);
+int rangeRng(Rng* pRng, int lo, int hi);
+double unitRng(Rng* pRng);
+
+#endif
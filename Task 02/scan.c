@@ -0,0 +1,340 @@
+/* PURPOSE: Vectorised (SSE2/AVX2) scanning kernels with a scalar fallback. The
+ * kernels are selected at runtime depending on the CPU.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Local Includes */
+#include "scan.h"
+#include "macros.h"
+
+/* Add SCAN_SCALAR to the CFLAGS to build the scalar kernels only */
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(SCAN_SCALAR)
+#define SCAN_SIMD
+#include <immintrin.h>
+#endif
+
+/**************************************************************************************************/
+/* Scalar Kernels														    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief First non-empty cell of a column (scalar).
+ *
+ * @param aCells first cell of the run.
+ * @param n number of cells in the run.
+ * @param stride distance between two cells of the run.
+ * @return int index of the cell, n if none.
+ */
+static int scanColumnForwardScalar(const char* aCells, int n, int stride)
+{
+	int i = 0;
+
+	while (i < n && aCells[(long) i * stride] == MARKER_EMPTY)
+		i++;
+
+	return i;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Last non-empty cell of a column (scalar).
+ *
+ * @param aCells first cell of the run.
+ * @param n number of cells in the run.
+ * @param stride distance between two cells of the run.
+ * @return int index of the cell, -1 if none.
+ */
+static int scanColumnReverseScalar(const char* aCells, int n, int stride)
+{
+	int i = n - 1;
+
+	while (i >= 0 && aCells[(long) i * stride] == MARKER_EMPTY)
+		i--;
+
+	return i;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief First non-empty cell of a row (scalar).
+ *
+ * @param aCells first cell of the run.
+ * @param n number of cells in the run.
+ * @return int index of the cell, n if none.
+ */
+static int scanRowForwardScalar(const char* aCells, int n)
+{
+	return scanColumnForwardScalar(aCells, n, 1);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Last non-empty cell of a row (scalar).
+ *
+ * @param aCells first cell of the run.
+ * @param n number of cells in the run.
+ * @return int index of the cell, -1 if none.
+ */
+static int scanRowReverseScalar(const char* aCells, int n)
+{
+	return scanColumnReverseScalar(aCells, n, 1);
+}
+
+#ifdef SCAN_SIMD
+/**************************************************************************************************/
+/* SSE2 Kernels															    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Non-empty cells mask of 16 cells (bit i is set if cell i is not empty).
+ *
+ * @param aCells first of the 16 cells.
+ * @return unsigned int the mask.
+ */
+__attribute__((target("sse2")))
+static unsigned int nonEmptyMaskSse2(const char* aCells)
+{
+	__m128i cells = _mm_loadu_si128((const __m128i*) aCells);
+	__m128i blank = _mm_set1_epi8(MARKER_EMPTY);
+
+	return ~((unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(cells, blank))) & 0xFFFFu;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief First non-empty cell of a row (SSE2, 16 cells at a time).
+ *
+ * @param aCells first cell of the run.
+ * @param n number of cells in the run.
+ * @return int index of the cell, n if none.
+ */
+__attribute__((target("sse2")))
+static int scanRowForwardSse2(const char* aCells, int n)
+{
+	int i = 0, found = n;
+
+	while (found == n && i + 16 <= n)
+	{
+		unsigned int mask = nonEmptyMaskSse2(aCells + i);
+
+		if (mask)
+			found = i + __builtin_ctz(mask);
+		else
+			i += 16;
+	}
+
+	return (found == n) ? i + scanRowForwardScalar(aCells + i, n - i) : found;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Last non-empty cell of a row (SSE2, 16 cells at a time).
+ *
+ * @param aCells first cell of the run.
+ * @param n number of cells in the run.
+ * @return int index of the cell, -1 if none.
+ */
+__attribute__((target("sse2")))
+static int scanRowReverseSse2(const char* aCells, int n)
+{
+	int i = n, found = -1;
+
+	while (found == -1 && i - 16 >= 0)
+	{
+		unsigned int mask = nonEmptyMaskSse2(aCells + i - 16);
+
+		if (mask)
+			found = i - 16 + 31 - __builtin_clz(mask);
+		else
+			i -= 16;
+	}
+
+	return (found == -1) ? scanRowReverseScalar(aCells, i) : found;
+}
+
+/**************************************************************************************************/
+/* AVX2 Kernels															    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Non-empty cells mask of 32 cells (bit i is set if cell i is not empty).
+ *
+ * @param aCells first of the 32 cells.
+ * @return unsigned int the mask.
+ */
+__attribute__((target("avx2")))
+static unsigned int nonEmptyMaskAvx2(const char* aCells)
+{
+	__m256i cells = _mm256_loadu_si256((const __m256i*) aCells);
+	__m256i blank = _mm256_set1_epi8(MARKER_EMPTY);
+
+	return ~((unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(cells, blank)));
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Non-empty cells mask of 8 cells of a column (gather, bit i is set if
+ * cell i is not empty). Each lane reads 4 bytes, the caller makes sure the
+ * last cell of the run is not gathered.
+ *
+ * @param aCells first of the 8 cells.
+ * @param stride distance between two cells of the run.
+ * @return unsigned int the mask.
+ */
+__attribute__((target("avx2")))
+static unsigned int nonEmptyColumnMaskAvx2(const char* aCells, int stride)
+{
+	__m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+											_mm256_set1_epi32(stride));
+	__m256i cells = _mm256_and_si256(_mm256_i32gather_epi32((const int*) aCells, offsets, 1),
+											_mm256_set1_epi32(0xFF));
+	__m256i isBlank = _mm256_cmpeq_epi32(cells, _mm256_set1_epi32(MARKER_EMPTY));
+
+	return ~((unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(isBlank))) & 0xFFu;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief First non-empty cell of a row (AVX2, 32 cells at a time).
+ *
+ * @param aCells first cell of the run.
+ * @param n number of cells in the run.
+ * @return int index of the cell, n if none.
+ */
+__attribute__((target("avx2")))
+static int scanRowForwardAvx2(const char* aCells, int n)
+{
+	int i = 0, found = n;
+
+	while (found == n && i + 32 <= n)
+	{
+		unsigned int mask = nonEmptyMaskAvx2(aCells + i);
+
+		if (mask)
+			found = i + __builtin_ctz(mask);
+		else
+			i += 32;
+	}
+
+	return (found == n) ? i + scanRowForwardSse2(aCells + i, n - i) : found;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Last non-empty cell of a row (AVX2, 32 cells at a time).
+ *
+ * @param aCells first cell of the run.
+ * @param n number of cells in the run.
+ * @return int index of the cell, -1 if none.
+ */
+__attribute__((target("avx2")))
+static int scanRowReverseAvx2(const char* aCells, int n)
+{
+	int i = n, found = -1;
+
+	while (found == -1 && i - 32 >= 0)
+	{
+		unsigned int mask = nonEmptyMaskAvx2(aCells + i - 32);
+
+		if (mask)
+			found = i - 32 + 31 - __builtin_clz(mask);
+		else
+			i -= 32;
+	}
+
+	return (found == -1) ? scanRowReverseSse2(aCells, i) : found;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief First non-empty cell of a column (AVX2 gather, 8 cells at a time).
+ *
+ * @param aCells first cell of the run.
+ * @param n number of cells in the run.
+ * @param stride distance between two cells of the run (4 or more).
+ * @return int index of the cell, n if none.
+ */
+__attribute__((target("avx2")))
+static int scanColumnForwardAvx2(const char* aCells, int n, int stride)
+{
+	int i = 0, found = n;
+
+	/* The last cell is never gathered (4 byte lanes must not read past the run) */
+	while (found == n && i + 8 < n)
+	{
+		unsigned int mask = nonEmptyColumnMaskAvx2(aCells + (long) i * stride, stride);
+
+		if (mask)
+			found = i + __builtin_ctz(mask);
+		else
+			i += 8;
+	}
+
+	return (found == n) ? i + scanColumnForwardScalar(aCells + (long) i * stride, n - i, stride)
+						: found;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Last non-empty cell of a column (AVX2 gather, 8 cells at a time).
+ *
+ * @param aCells first cell of the run.
+ * @param n number of cells in the run.
+ * @param stride distance between two cells of the run (4 or more).
+ * @return int index of the cell, -1 if none.
+ */
+__attribute__((target("avx2")))
+static int scanColumnReverseAvx2(const char* aCells, int n, int stride)
+{
+	/* The last cell is never gathered (4 byte lanes must not read past the run) */
+	int i = (n > 0) ? n - 1 : 0;
+	int found = (n > 0 && aCells[(long) i * stride] != MARKER_EMPTY) ? i : -1;
+
+	while (found == -1 && i - 8 >= 0)
+	{
+		unsigned int mask = nonEmptyColumnMaskAvx2(aCells + (long) (i - 8) * stride, stride);
+
+		if (mask)
+			found = i - 8 + 31 - __builtin_clz(mask);
+		else
+			i -= 8;
+	}
+
+	return (found == -1) ? scanColumnReverseScalar(aCells, i, stride) : found;
+}
+#endif
+
+/**************************************************************************************************/
+/* Kernel Selection Methods												    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Select the fastest scanning kernels supported by the CPU (AVX2, SSE2
+ * or scalar).
+ *
+ * @param pKernels export variable for the selected kernels.
+ */
+void selectScanKernels(ScanKernels* pKernels)
+{
+	pKernels->pRowForward = &scanRowForwardScalar;
+	pKernels->pRowReverse = &scanRowReverseScalar;
+	pKernels->pColumnForward = &scanColumnForwardScalar;
+	pKernels->pColumnReverse = &scanColumnReverseScalar;
+
+#ifdef SCAN_SIMD
+	__builtin_cpu_init();
+
+	/* SSE2 has no gather, columns stay scalar */
+	if (__builtin_cpu_supports("sse2"))
+	{
+		pKernels->pRowForward = &scanRowForwardSse2;
+		pKernels->pRowReverse = &scanRowReverseSse2;
+	}
+
+	if (__builtin_cpu_supports("avx2"))
+	{
+		pKernels->pRowForward = &scanRowForwardAvx2;
+		pKernels->pRowReverse = &scanRowReverseAvx2;
+		pKernels->pColumnForward = &scanColumnForwardAvx2;
+		pKernels->pColumnReverse = &scanColumnReverseAvx2;
+	}
+#endif
+}
@@ -0,0 +1,19 @@
+#ifndef SCAN_H
+#define SCAN_H
+
+/* Scanning kernels: search the first/last non-empty cell in a run of cells */
+typedef int (*RowScan)(const char* aCells, int n);
+typedef int (*ColumnScan)(const char* aCells, int n, int stride);
+
+typedef struct ScanKernels
+{
+	RowScan pRowForward;		/* first non-empty cell in [0, n), n if none */
+	RowScan pRowReverse;		/* last non-empty cell in [0, n), -1 if none */
+	ColumnScan pColumnForward;	/* same as pRowForward, cells are `stride` apart */
+	ColumnScan pColumnReverse;	/* same as pRowReverse, cells are `stride` apart */
+} ScanKernels;
+
+/* Kernel Selection Methods */
+void selectScanKernels(ScanKernels* pKernels);
+
+#endif
@@ -0,0 +1,862 @@
+/* PURPOSE: Level solver: searches the shortest winning key sequence of a level
+ * with a breadth first search over the player states (cell, facing, enemies
+ * alive). Each BFS level is expanded by a pool of threads.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+#define _DEFAULT_SOURCE
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+/* Local Includes */
+#include "tankcore.h"
+#include "envinit.h"
+#include "threat.h"
+#include "enemy.h"
+#include "trace.h"
+#include "cellhash.h"
+#include "util.h"
+#include "toolutil.h"
+#include "macros.h"
+
+/* Object Definitions */
+typedef struct SolverStage
+{
+	uint64_t aliveMask;			/* bit i is set if enemy i is alive */
+	uint64_t* alParents;		/* 4 bits per state: how it was reached, 0 if not visited */
+	uint64_t* alSafe;			/* one bit per cell: empty and out of every line of fire */
+	uint64_t* alShots;			/* one bit per state: a shot from the state destroys an enemy */
+	CellHash* pKills;			/* state -> enemy destroyed by a shot from the state */
+	CellHash* pShotFrom;		/* state reached by a shot -> enemy destroyed by the shot */
+} SolverStage;
+
+typedef struct SolverNode
+{
+	int stageIdx;
+	long state;					/* (row * cols + col) * 4 + direction index */
+} SolverNode;
+
+typedef struct SolverKill
+{
+	SolverNode from;			/* state the shot is fired from */
+	int enemyIdx;				/* enemy destroyed, some enemies are still alive */
+} SolverKill;
+
+typedef struct SolverWorker
+{
+	struct Solver* pSolver;
+	int workerIdx;
+	SolverNode* aNext;			/* states claimed for the next BFS level */
+	long nNext;
+	long nextCapacity;
+	SolverKill* aKills;			/* shots leading to a new stage, claimed after the level */
+	int nKills;
+	int killCapacity;
+	int isWon;					/* a shot from wonNode destroys the last enemy */
+	SolverNode wonNode;
+	pthread_t thread;
+} SolverWorker;
+
+typedef struct Solver
+{
+	TankCore* pCore;			/* the level: board, enemies and lines of fire */
+	int rows;
+	int cols;
+	long nStates;
+	uint64_t* alOpen;			/* one bit per cell: empty once every enemy is destroyed */
+	int* aiStamps;				/* scratch: last kill chain through each cell */
+	int chainId;
+	SolverStage* aStages;		/* one per set of enemies alive, the first is the start */
+	int nStages;
+	SolverNode* aFrontier;		/* states of the current BFS level */
+	long nFrontier;
+	long frontierCapacity;
+	long nExplored;
+	int depth;					/* keys to reach the states of the frontier */
+	int isTruncated;			/* some stages were not searched (SOLVER_MAX_STAGES) */
+	SolverWorker* aWorkers;
+	int nWorkers;
+	pthread_barrier_t oStart;	/* a BFS level starts (or the search is over) */
+	pthread_barrier_t oEnd;		/* every worker expanded its slice of the frontier */
+	int isDone;
+} Solver;
+
+/* Directions in state order, the opposite direction is index ^ 1 */
+static const char acStateDirections[4] = {DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT};
+static const char acStateKeys[4] = {KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT};
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Index of a direction in the states.
+ *
+ * @param direction direction.
+ * @return int direction index (0 to 3).
+ */
+static int directionIndex(char direction)
+{
+	int dirIdx = 0;
+
+	while (dirIdx < 3 && acStateDirections[dirIdx] != direction)
+		dirIdx++;
+
+	return dirIdx;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Whether the bit is set in the bit set.
+ *
+ * @param alBits bit set.
+ * @param idx bit index.
+ * @return int TRUE if set.
+ */
+static int testBit(const uint64_t* alBits, long idx)
+{
+	return (alBits[idx >> BITBOARD_WORD_SHIFT] >> (idx & BITBOARD_WORD_MASK)) & 1;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Set or clear the bit in the bit set.
+ *
+ * @param alBits bit set.
+ * @param idx bit index.
+ * @param isSet TRUE to set the bit, FALSE to clear it.
+ */
+static void writeBit(uint64_t* alBits, long idx, int isSet)
+{
+	uint64_t bit = BITBOARD_ONE << (idx & BITBOARD_WORD_MASK);
+
+	if (isSet)
+		alBits[idx >> BITBOARD_WORD_SHIFT] |= bit;
+	else
+		alBits[idx >> BITBOARD_WORD_SHIFT] &= ~bit;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief How a state was reached (SOLVER_PARENT_...), 0 if not visited.
+ *
+ * @param pStage stage of the state.
+ * @param state state index.
+ * @return int parent code.
+ */
+static int readParent(const SolverStage* pStage, long state)
+{
+	return (int) (pStage->alParents[state >> SOLVER_PARENT_SHIFT] >>
+						((state & SOLVER_PARENT_MASK) * 4)) & 0xF;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Mark states of a cell visited. Safe to call from several workers at
+ * once, exactly one of them claims each state.
+ *
+ * @param pStage stage of the states.
+ * @param cellKey cell of the states.
+ * @param dirMask bit i is set to claim the state facing direction index i.
+ * @param parent how the states are reached (SOLVER_PARENT_...).
+ * @return int bit i is set if the state facing direction index i was claimed.
+ */
+static int claimStates(SolverStage* pStage, long cellKey, int dirMask, int parent)
+{
+	/* The 4 states of a cell are 16 bits of the same word */
+	uint64_t* plWord = &(pStage->alParents[(cellKey * 4) >> SOLVER_PARENT_SHIFT]);
+	int shift = (int) ((cellKey * 4) & SOLVER_PARENT_MASK) * 4;
+	uint64_t word = __atomic_load_n(plWord, __ATOMIC_RELAXED);
+	uint64_t newWord;
+	int i, claimMask;
+
+	/* PERF: Most states are visited already, nothing is written then */
+	do
+	{
+		claimMask = 0;
+		newWord = word;
+		for (i = 0; i < 4; i++)
+		{
+			if (((dirMask >> i) & 1) && ((word >> (shift + i * 4)) & 0xF) == 0)
+			{
+				claimMask |= 1 << i;
+				newWord |= (uint64_t) parent << (shift + i * 4);
+			}
+		}
+	} while (claimMask && !__atomic_compare_exchange_n(plWord, &word, newWord, FALSE,
+											__ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+	return claimMask;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Append a state to the list, growing it if needed.
+ *
+ * @param paNodes list of states.
+ * @param pnNodes number of states in the list.
+ * @param pCapacity capacity of the list.
+ * @param stageIdx stage of the state.
+ * @param state state index.
+ */
+static void pushNode(SolverNode** paNodes, long* pnNodes, long* pCapacity, int stageIdx, long state)
+{
+	if (*pnNodes == *pCapacity)
+	{
+		*pCapacity *= 2;
+		*paNodes = (SolverNode*) realloc(*paNodes, sizeof(SolverNode) * (*pCapacity));
+	}
+
+	(*paNodes)[*pnNodes].stageIdx = stageIdx;
+	(*paNodes)[*pnNodes].state = state;
+	(*pnNodes)++;
+}
+
+/**************************************************************************************************/
+/* Stage Methods														    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Record the cell as a shot position: facing back along the chain, a
+ * shot from the cell flies the chain backwards to the enemy. Only the first
+ * pass of the chain over a cell counts, the later ones would shoot the player
+ * on the way.
+ *
+ * @param pSolver solver object.
+ * @param pStage stage being built.
+ * @param enemyIdx enemy at the start of the chain.
+ * @param pCell cell of the chain and the direction it is passed in.
+ */
+static void addKill(Solver* pSolver, SolverStage* pStage, int enemyIdx, const GameObj* pCell)
+{
+	long cellKey = (long) pCell->row * pSolver->cols + pCell->col;
+	long state = cellKey * 4 + (directionIndex(pCell->direction) ^ 1);
+
+	if (pSolver->aiStamps[cellKey] != pSolver->chainId)
+	{
+		pSolver->aiStamps[cellKey] = pSolver->chainId;
+		writeBit(pStage->alShots, state, TRUE);
+		insertCellHash(pStage->pKills, state, enemyIdx);
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Follow a player bullet backwards, from the enemy out in one
+ * direction, reflecting on the mirrors as `shoot()` bullets do. Bullet paths
+ * are reversible, so every cell passed can shoot the enemy.
+ *
+ * @param pSolver solver object.
+ * @param pStage stage being built, its board is on the map.
+ * @param enemyIdx index of the enemy.
+ * @param dirIdx direction index the chain leaves the enemy in.
+ */
+static void collectKillChain(Solver* pSolver, SolverStage* pStage, int enemyIdx, int dirIdx)
+{
+	MapInfo* pMapInfo = pSolver->pCore->oRP.pMapInfo;
+	int dRow, dCol, obstacle;
+	int isReflected = TRUE;
+	char marker;
+	GameObj cell;
+
+	getEnemy(pSolver->pCore->oRP.pEnemies, enemyIdx, &cell);
+	cell.direction = acStateDirections[dirIdx];
+	directionStep(cell.direction, &dRow, &dCol);
+	cell.row += dRow;
+	cell.col += dCol;
+	pSolver->chainId++;
+
+	/* The chain starts at a tank, it cannot run in a cycle. Refer trace.c */
+	while (isReflected)
+	{
+		int isVertical = (cell.direction == DIR_UP || cell.direction == DIR_DOWN);
+
+		/* PERF: Jump to the next obstacle (bitboard / SIMD scan) */
+		obstacle = findObstacle(pMapInfo, cell.row, cell.col, cell.direction);
+		while ((isVertical ? cell.row : cell.col) != obstacle)
+		{
+			addKill(pSolver, pStage, enemyIdx, &cell);
+			cell.row += dRow;
+			cell.col += dCol;
+		}
+
+		marker = getCell(pMapInfo, cell.row, cell.col);
+		isReflected = (marker == MARKER_FACE_BMIRROR || marker == MARKER_FACE_FMIRROR);
+		if (isReflected)
+		{
+			cell.direction = reflectDirection(marker, cell.direction);
+			directionStep(cell.direction, &dRow, &dCol);
+			cell.row += dRow;
+			cell.col += dCol;
+		}
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Index of the stage of a set of enemies alive.
+ *
+ * @param pSolver solver object.
+ * @param aliveMask enemies alive.
+ * @return int stage index, -1 if not built.
+ */
+static int findStage(const Solver* pSolver, uint64_t aliveMask)
+{
+	int stageIdx = pSolver->nStages - 1;
+
+	while (stageIdx >= 0 && pSolver->aStages[stageIdx].aliveMask != aliveMask)
+		stageIdx--;
+
+	return stageIdx;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Build the stage of a set of enemies alive: the board without the
+ * destroyed enemies, the cells safe to move to (same lines of fire as the
+ * game, refer threat.c) and the shots that destroy an enemy. Not thread safe,
+ * the workers wait.
+ *
+ * @param pSolver solver object.
+ * @param aliveMask enemies alive.
+ * @return int stage index, -1 if SOLVER_MAX_STAGES stages are built.
+ */
+static int addStage(Solver* pSolver, uint64_t aliveMask)
+{
+	RefreshMapParam* pRP = &(pSolver->pCore->oRP);
+	EnemySet* pEnemies = pRP->pEnemies;
+	long nCells = (long) pSolver->rows * pSolver->cols;
+	long cellWords = (nCells + BITBOARD_WORD_MASK) >> BITBOARD_WORD_SHIFT;
+	long stateWords = (pSolver->nStates + BITBOARD_WORD_MASK) >> BITBOARD_WORD_SHIFT;
+	int i, j, stageIdx = -1;
+	SolverStage* pStage;
+	GameObj enemy;
+
+	if (pSolver->nStages < SOLVER_MAX_STAGES)
+	{
+		stageIdx = pSolver->nStages++;
+		pStage = &(pSolver->aStages[stageIdx]);
+		pStage->aliveMask = aliveMask;
+		pStage->alParents = (uint64_t*) calloc((pSolver->nStates + SOLVER_PARENT_MASK) >>
+														SOLVER_PARENT_SHIFT, sizeof(uint64_t));
+		pStage->alShots = (uint64_t*) calloc(stateWords, sizeof(uint64_t));
+		pStage->alSafe = (uint64_t*) malloc(sizeof(uint64_t) * cellWords);
+		pStage->pKills = createCellHash(CELL_HASH_INIT_CAPACITY);
+		pStage->pShotFrom = createCellHash(CELL_HASH_INIT_CAPACITY);
+
+		/* The board of the stage, the player is placed nowhere: it blocks no line */
+		reviveEnemies(pEnemies);
+		for (i = 0; i < pEnemies->nEnemies; i++)
+		{
+			if (!((aliveMask >> i) & 1))
+				killEnemy(pEnemies, i);
+		}
+
+		resetMap(pRP->pMapInfo);
+		placeEnemies(pRP->pMapInfo, pEnemies);
+		placeMirrors(pRP->pMapInfo, pRP->pMirrorList);
+		invalidateThreatMask(pRP->pThreat);
+		refreshThreatMask(pRP->pThreat, pRP->pMapInfo, pEnemies, NULL);
+
+		/* PERF: Only the enemy cells and the lines of fire differ from the open board */
+		memcpy(pStage->alSafe, pSolver->alOpen, sizeof(uint64_t) * cellWords);
+		for (i = 0; i < pEnemies->nEnemies; i++)
+		{
+			const EnemyFire* pFire = &(pRP->pThreat->aFires[i]);
+
+			if (pEnemies->aIsAlive[i])
+			{
+				getEnemy(pEnemies, i, &enemy);
+				writeBit(pStage->alSafe, (long) enemy.row * pSolver->cols + enemy.col, FALSE);
+
+				for (j = 0; j < pFire->nCells; j++)
+					writeBit(pStage->alSafe, pFire->alCells[j], FALSE);
+			}
+		}
+
+		for (i = 0; i < pEnemies->nEnemies; i++)
+		{
+			for (j = 0; pEnemies->aIsAlive[i] && j < 4; j++)
+				collectKillChain(pSolver, pStage, i, j);
+		}
+	}
+	else
+		pSolver->isTruncated = TRUE;
+
+	return stageIdx;
+}
+
+/**************************************************************************************************/
+/* Search Methods														    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Expand a state with the rules of `turnOrMove()` and `shoot()`: a key
+ * turns the player, or moves it if it faces that way already. A move into a
+ * line of fire is lost, a shot only matters if it destroys an enemy.
+ *
+ * @param pWorker worker object.
+ * @param pNode state to expand.
+ */
+static void expandNode(SolverWorker* pWorker, const SolverNode* pNode)
+{
+	Solver* pSolver = pWorker->pSolver;
+	SolverStage* pStage = &(pSolver->aStages[pNode->stageIdx]);
+	long cellKey = pNode->state >> 2;
+	int dirIdx = (int) (pNode->state & 3);
+	int i, dRow, dCol, enemyIdx, claimMask;
+	long nextKey;
+
+	/* Turns: the other directions of the cell */
+	claimMask = claimStates(pStage, cellKey, 0xF & ~(1 << dirIdx), SOLVER_PARENT_TURN + dirIdx);
+	for (i = 0; i < 4; i++)
+	{
+		if ((claimMask >> i) & 1)
+		{
+			pushNode(&(pWorker->aNext), &(pWorker->nNext), &(pWorker->nextCapacity),
+							pNode->stageIdx, cellKey * 4 + i);
+		}
+	}
+
+	/* Move: border cells are never safe, the step stays on the map */
+	directionStep(acStateDirections[dirIdx], &dRow, &dCol);
+	nextKey = cellKey + (long) dRow * pSolver->cols + dCol;
+	if (testBit(pStage->alSafe, nextKey) &&
+			claimStates(pStage, nextKey, 1 << dirIdx, SOLVER_PARENT_STEP))
+	{
+		pushNode(&(pWorker->aNext), &(pWorker->nNext), &(pWorker->nextCapacity),
+						pNode->stageIdx, nextKey * 4 + dirIdx);
+	}
+
+	/* Shot: PERF: bit test first, the hash is looked up on a shot position only */
+	enemyIdx = testBit(pStage->alShots, pNode->state) ?
+						lookupCellHash(pStage->pKills, pNode->state, -1) : -1;
+
+	if (enemyIdx != -1 && (pStage->aliveMask & ~(BITBOARD_ONE << enemyIdx)) == 0)
+	{
+		if (!pWorker->isWon)
+		{
+			pWorker->isWon = TRUE;
+			pWorker->wonNode = *pNode;
+		}
+	}
+	else if (enemyIdx != -1)
+	{
+		/* The next stage may not be built yet, it is claimed after the level */
+		if (pWorker->nKills == pWorker->killCapacity)
+		{
+			pWorker->killCapacity *= 2;
+			pWorker->aKills = (SolverKill*) realloc(pWorker->aKills,
+											sizeof(SolverKill) * pWorker->killCapacity);
+		}
+
+		pWorker->aKills[pWorker->nKills].from = *pNode;
+		pWorker->aKills[pWorker->nKills].enemyIdx = enemyIdx;
+		pWorker->nKills++;
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Expand the worker's slice of the frontier.
+ *
+ * @param pWorker worker object.
+ */
+static void expandSlice(SolverWorker* pWorker)
+{
+	Solver* pSolver = pWorker->pSolver;
+	long i;
+	long lo = pSolver->nFrontier * pWorker->workerIdx / pSolver->nWorkers;
+	long hi = pSolver->nFrontier * (pWorker->workerIdx + 1) / pSolver->nWorkers;
+
+	pWorker->nNext = 0;
+	pWorker->nKills = 0;
+	for (i = lo; i < hi; i++)
+		expandNode(pWorker, &(pSolver->aFrontier[i]));
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Worker thread: expand a slice of each BFS level until the search is
+ * over. The first worker is the main thread.
+ *
+ * @param pContext worker object.
+ * @return void* NULL.
+ */
+static void* runWorker(void* pContext)
+{
+	SolverWorker* pWorker = (SolverWorker*) pContext;
+	Solver* pSolver = pWorker->pSolver;
+	int isRunning = TRUE;
+
+	while (isRunning)
+	{
+		pthread_barrier_wait(&(pSolver->oStart));
+		isRunning = !pSolver->isDone;
+
+		if (isRunning)
+		{
+			expandSlice(pWorker);
+			pthread_barrier_wait(&(pSolver->oEnd));
+		}
+	}
+
+	return NULL;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Gather the next BFS level from the workers (in worker order) and
+ * claim the states reached by destroying an enemy.
+ *
+ * @param pSolver solver object.
+ */
+static void gatherFrontier(Solver* pSolver)
+{
+	int i, j;
+
+	pSolver->nFrontier = 0;
+	for (i = 0; i < pSolver->nWorkers; i++)
+	{
+		SolverWorker* pWorker = &(pSolver->aWorkers[i]);
+
+		for (j = 0; j < pWorker->nNext; j++)
+		{
+			pushNode(&(pSolver->aFrontier), &(pSolver->nFrontier), &(pSolver->frontierCapacity),
+							pWorker->aNext[j].stageIdx, pWorker->aNext[j].state);
+		}
+	}
+
+	for (i = 0; i < pSolver->nWorkers; i++)
+	{
+		SolverWorker* pWorker = &(pSolver->aWorkers[i]);
+
+		for (j = 0; j < pWorker->nKills; j++)
+		{
+			const SolverKill* pKill = &(pWorker->aKills[j]);
+			uint64_t aliveMask = pSolver->aStages[pKill->from.stageIdx].aliveMask &
+									~(BITBOARD_ONE << pKill->enemyIdx);
+			int stageIdx = findStage(pSolver, aliveMask);
+
+			if (stageIdx == -1)
+				stageIdx = addStage(pSolver, aliveMask);
+
+			if (stageIdx != -1 && claimStates(&(pSolver->aStages[stageIdx]),
+						pKill->from.state >> 2, 1 << (pKill->from.state & 3), SOLVER_PARENT_SHOT))
+			{
+				insertCellHash(pSolver->aStages[stageIdx].pShotFrom, pKill->from.state,
+									pKill->enemyIdx);
+				pushNode(&(pSolver->aFrontier), &(pSolver->nFrontier),
+							&(pSolver->frontierCapacity), stageIdx, pKill->from.state);
+			}
+		}
+	}
+
+	pSolver->nExplored += pSolver->nFrontier;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief The state one key before the state on its shortest path.
+ *
+ * @param pSolver solver object.
+ * @param pNode state, export variable for the state before it.
+ * @return char the key from the state before to the state.
+ */
+static char findParent(const Solver* pSolver, SolverNode* pNode)
+{
+	const SolverStage* pStage = &(pSolver->aStages[pNode->stageIdx]);
+	long cellKey = pNode->state >> 2;
+	int dRow, dCol, enemyIdx, dirIdx = (int) (pNode->state & 3);
+	int parent = readParent(pStage, pNode->state);
+	char key = acStateKeys[dirIdx];
+
+	if (parent == SOLVER_PARENT_SHOT)
+	{
+		enemyIdx = lookupCellHash(pStage->pShotFrom, pNode->state, -1);
+		pNode->stageIdx = findStage(pSolver, pStage->aliveMask | (BITBOARD_ONE << enemyIdx));
+		key = KEY_SHOOT;
+	}
+	else if (parent == SOLVER_PARENT_STEP)
+	{
+		directionStep(acStateDirections[dirIdx], &dRow, &dCol);
+		pNode->state = (cellKey - (long) dRow * pSolver->cols - dCol) * 4 + dirIdx;
+	}
+	else
+		pNode->state = cellKey * 4 + (parent - SOLVER_PARENT_TURN);
+
+	return key;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Keys leading to the won state, followed by the winning shot.
+ *
+ * @param pSolver solver object.
+ * @param pWonNode state the winning shot is fired from.
+ * @return char* the keys (malloc()).
+ */
+static char* traceMoves(const Solver* pSolver, const SolverNode* pWonNode)
+{
+	SolverNode node = *pWonNode;
+	char* zMoves = (char*) malloc(pSolver->depth + 2);
+	int i;
+
+	zMoves[pSolver->depth] = KEY_SHOOT;
+	zMoves[pSolver->depth + 1] = '\0';
+
+	for (i = pSolver->depth - 1; i >= 0; i--)
+		zMoves[i] = findParent(pSolver, &node);
+
+	return zMoves;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Search the shortest winning key sequence from the start of the level.
+ *
+ * @param pSolver solver object, with the start stage built.
+ * @return char* the keys (malloc()), NULL if the level cannot be won.
+ */
+static char* solveLevel(Solver* pSolver)
+{
+	const GameObj* pPlayer = &(pSolver->pCore->oStPlayer);
+	long stCellKey = (long) pPlayer->row * pSolver->cols + pPlayer->col;
+	int i, stDirIdx = directionIndex(pPlayer->direction), isOver = FALSE;
+	char* zMoves = NULL;
+
+	claimStates(&(pSolver->aStages[0]), stCellKey, 1 << stDirIdx, SOLVER_PARENT_START);
+	pushNode(&(pSolver->aFrontier), &(pSolver->nFrontier), &(pSolver->frontierCapacity), 0,
+					stCellKey * 4 + stDirIdx);
+	pSolver->nExplored = 1;
+
+	for (i = 1; i < pSolver->nWorkers; i++)
+		pthread_create(&(pSolver->aWorkers[i].thread), NULL, &runWorker, &(pSolver->aWorkers[i]));
+
+	while (!isOver)
+	{
+		pthread_barrier_wait(&(pSolver->oStart));
+		expandSlice(&(pSolver->aWorkers[0]));
+		pthread_barrier_wait(&(pSolver->oEnd));
+
+		/* Same depth for all the wins of the level, the first worker's is kept */
+		for (i = 0; !zMoves && i < pSolver->nWorkers; i++)
+		{
+			if (pSolver->aWorkers[i].isWon)
+				zMoves = traceMoves(pSolver, &(pSolver->aWorkers[i].wonNode));
+		}
+
+		if (!zMoves)
+		{
+			gatherFrontier(pSolver);
+			pSolver->depth++;
+		}
+
+		isOver = (zMoves || pSolver->nFrontier == 0);
+	}
+
+	pSolver->isDone = TRUE;
+	pthread_barrier_wait(&(pSolver->oStart));
+
+	for (i = 1; i < pSolver->nWorkers; i++)
+		pthread_join(pSolver->aWorkers[i].thread, NULL);
+
+	return zMoves;
+}
+
+/**************************************************************************************************/
+/* Solver Managment Methods												    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Create a solver object for the loaded level and build its start
+ * stage (every enemy alive).
+ *
+ * @param pCore tank core object, with a level loaded.
+ * @param nWorkers number of threads.
+ * @return Solver* solver object.
+ */
+static Solver* createSolver(TankCore* pCore, int nWorkers)
+{
+	Solver* pSolver = (Solver*) calloc(1, sizeof(Solver));
+	EnemySet* pEnemies = pCore->oRP.pEnemies;
+	int i, row, col;
+	GameObj enemy;
+
+	pSolver->pCore = pCore;
+	pSolver->rows = pCore->oRP.pMapInfo->rows;
+	pSolver->cols = pCore->oRP.pMapInfo->cols;
+	pSolver->nStates = (long) pSolver->rows * pSolver->cols * 4;
+	pSolver->aiStamps = (int*) calloc((long) pSolver->rows * pSolver->cols, sizeof(int));
+	pSolver->alOpen = (uint64_t*) calloc(((long) pSolver->rows * pSolver->cols +
+										BITBOARD_WORD_MASK) >> BITBOARD_WORD_SHIFT, sizeof(uint64_t));
+	pSolver->aStages = (SolverStage*) malloc(sizeof(SolverStage) * SOLVER_MAX_STAGES);
+	pSolver->frontierCapacity = 64;
+	pSolver->aFrontier = (SolverNode*) malloc(sizeof(SolverNode) * pSolver->frontierCapacity);
+
+	/* Open board: the cells left once every enemy is destroyed (the map holds the level) */
+	for (row = 1; row < pSolver->rows - 1; row++)
+	{
+		for (col = 1; col < pSolver->cols - 1; col++)
+		{
+			char cell = getCell(pCore->oRP.pMapInfo, row, col);
+			writeBit(pSolver->alOpen, (long) row * pSolver->cols + col,
+						cell != MARKER_FACE_BMIRROR && cell != MARKER_FACE_FMIRROR);
+		}
+	}
+
+	for (i = 0; i < pEnemies->nEnemies; i++)
+	{
+		getEnemy(pEnemies, i, &enemy);
+		writeBit(pSolver->alOpen, (long) enemy.row * pSolver->cols + enemy.col, TRUE);
+	}
+
+	pSolver->nWorkers = nWorkers;
+	pSolver->aWorkers = (SolverWorker*) calloc(nWorkers, sizeof(SolverWorker));
+	for (i = 0; i < nWorkers; i++)
+	{
+		pSolver->aWorkers[i].pSolver = pSolver;
+		pSolver->aWorkers[i].workerIdx = i;
+		pSolver->aWorkers[i].nextCapacity = 64;
+		pSolver->aWorkers[i].aNext = (SolverNode*) malloc(sizeof(SolverNode) * 64);
+		pSolver->aWorkers[i].killCapacity = 16;
+		pSolver->aWorkers[i].aKills = (SolverKill*) malloc(sizeof(SolverKill) * 16);
+	}
+
+	pthread_barrier_init(&(pSolver->oStart), NULL, nWorkers);
+	pthread_barrier_init(&(pSolver->oEnd), NULL, nWorkers);
+
+	addStage(pSolver, (pEnemies->nEnemies == SOLVER_MAX_ENEMIES) ? BITBOARD_ALL :
+						(BITBOARD_ONE << pEnemies->nEnemies) - 1);
+
+	return pSolver;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy the solver object. Call free().
+ *
+ * @param pSolver solver object.
+ */
+static void destroySolver(Solver* pSolver)
+{
+	int i;
+
+	for (i = 0; i < pSolver->nStages; i++)
+	{
+		free(pSolver->aStages[i].alParents);
+		free(pSolver->aStages[i].alSafe);
+		free(pSolver->aStages[i].alShots);
+		destroyCellHash(pSolver->aStages[i].pKills);
+		destroyCellHash(pSolver->aStages[i].pShotFrom);
+	}
+
+	for (i = 0; i < pSolver->nWorkers; i++)
+	{
+		free(pSolver->aWorkers[i].aNext);
+		free(pSolver->aWorkers[i].aKills);
+	}
+
+	pthread_barrier_destroy(&(pSolver->oStart));
+	pthread_barrier_destroy(&(pSolver->oEnd));
+	free(pSolver->aWorkers);
+	free(pSolver->aFrontier);
+	free(pSolver->aStages);
+	free(pSolver->aiStamps);
+	free(pSolver->alOpen);
+	free(pSolver);
+}
+
+/**************************************************************************************************/
+/* Main																	    	      		  */
+/**************************************************************************************************/
+int main(int argc, char *argv[])
+{
+	GameOptions options;
+	TankCore* pCore = createTankCore();
+	Solver* pSolver;
+	const char* zScriptFileName = NULL;
+	struct timespec start;
+	int i, nWorkers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	int exitCode = EXIT_INIT_ERROR;
+	char* zMoves;
+	FILE* pFile;
+
+	memset(&options, 0, sizeof(GameOptions));
+
+	/* Optional flags after the level file */
+	for (i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-m") == 0)
+			options.isMirrorFire = TRUE;
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+			nWorkers = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+			zScriptFileName = argv[++i];
+		else
+			argc = 0;
+	}
+
+	if (argc < 2 || nWorkers < 1)
+	{
+		printf("Usage: %s <level file> [-m] [-t threads] [-o script file]\n", argv[0]);
+		printf("  -m  enemies bank shots off the mirrors\n");
+		printf("  -t  number of worker threads (default: one per core)\n");
+		printf("  -o  write the winning keys as a move script (for -x and batch)\n");
+	}
+	else if (resetTankCore(pCore, argv[1], &options) &&
+				pCore->oRP.pEnemies->nEnemies > SOLVER_MAX_ENEMIES)
+	{
+		printf("The solver handles up to %d enemies\n", SOLVER_MAX_ENEMIES);
+	}
+	else if (pCore->isLoaded)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		pSolver = createSolver(pCore, nWorkers);
+		zMoves = solveLevel(pSolver);
+
+		if (zMoves && pSolver->isTruncated)
+			printf("Winnable in %d moves (some sets of enemies alive not searched): %s\n",
+						(int) strlen(zMoves), zMoves);
+		else if (zMoves)
+			printf("Winnable in %d moves: %s\n", (int) strlen(zMoves), zMoves);
+		else if (pSolver->isTruncated)
+			printf("No win found within %d sets of enemies alive\n", SOLVER_MAX_STAGES);
+		else
+			printf("Not winnable\n");
+
+		printf("%ld states explored over %d sets of enemies alive, %d threads, %.1f ms\n",
+					pSolver->nExplored, pSolver->nStages, nWorkers, elapsedMs(&start));
+
+		exitCode = zMoves ? EXIT_WON : EXIT_LOST;
+		if (zMoves && zScriptFileName)
+		{
+			pFile = fopen(zScriptFileName, "w");
+			if (pFile)
+			{
+				fprintf(pFile, "%s\n", zMoves);
+				fclose(pFile);
+			}
+			else
+			{
+				perror("Could not open the script file");
+				exitCode = EXIT_SAVE_ERROR;
+			}
+		}
+
+		free(zMoves);
+		destroySolver(pSolver);
+	}
+	else
+	{
+		fprintf(stderr, "%s: %s\n", argv[1], loadErrorMessage(pCore->loadError));
+	}
+
+	destroyTankCore(pCore);
+
+	return exitCode;
+}
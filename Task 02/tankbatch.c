@@ -0,0 +1,518 @@
+/* PURPOSE: Batch of tank games stepped in lockstep (one action per instance
+ * and per call), for trainers and tools. The instances share the level and
+ * keep their state in structure of arrays.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* Local Includes */
+#include "tankbatch.h"
+#include "util.h"
+#include "enemy.h"
+#include "trace.h"
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Add the cell to the line of fire of the enemy. The blockers found so
+ * far on the line are the ones that must be destroyed for the fire to get
+ * there.
+ *
+ * @param pBatch tank batch object.
+ * @param enemyIdx index of the enemy.
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ */
+static void addFireEntry(TankBatch* pBatch, int enemyIdx, int row, int col)
+{
+	long key = (long) row * pBatch->pBoard->cols + col;
+	int entry = pBatch->nEntries++;
+
+	if (entry == pBatch->entryCapacity)
+	{
+		pBatch->entryCapacity *= 2;
+		pBatch->aiEntryEnemy = (int*) realloc(pBatch->aiEntryEnemy, 
+												sizeof(int) * pBatch->entryCapacity);
+		pBatch->aiEntryBlockers = (int*) realloc(pBatch->aiEntryBlockers, 
+												sizeof(int) * pBatch->entryCapacity);
+		pBatch->aiEntryNext = (int*) realloc(pBatch->aiEntryNext, 
+												sizeof(int) * pBatch->entryCapacity);
+	}
+
+	pBatch->aiEntryEnemy[entry] = enemyIdx;
+	pBatch->aiEntryBlockers[entry] = pBatch->nBlockers - pBatch->aiBlockerStart[enemyIdx];
+	pBatch->aiEntryNext[entry] = lookupCellHash(pBatch->pFireCells, key, -1);
+	insertCellHash(pBatch->pFireCells, key, entry);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Add an enemy standing on the line of fire being collected.
+ *
+ * @param pBatch tank batch object.
+ * @param blockerIdx index of the enemy in the way.
+ */
+static void addBlocker(TankBatch* pBatch, int blockerIdx)
+{
+	if (pBatch->nBlockers == pBatch->blockerCapacity)
+	{
+		pBatch->blockerCapacity *= 2;
+		pBatch->aiBlockers = (int*) realloc(pBatch->aiBlockers, 
+												sizeof(int) * pBatch->blockerCapacity);
+	}
+
+	pBatch->aiBlockers[pBatch->nBlockers++] = blockerIdx;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Collect the line of fire of the enemy as if no other enemy was on
+ * the board: the enemies in the way are recorded as blockers and the line
+ * goes on past them. The player does not block the line of fire, the same as
+ * in the game. Refer threat.c.
+ *
+ * @param pBatch tank batch object.
+ * @param enemyIdx index of the enemy.
+ * @param pEnemy enemy object.
+ */
+static void collectEnemyFire(TankBatch* pBatch, int enemyIdx, const GameObj* pEnemy)
+{
+	int dRow, dCol, obstacle, blockerIdx;
+	int isOpen = TRUE;
+	GameObj cell = *pEnemy;
+	char marker;
+
+	pBatch->aiBlockerStart[enemyIdx] = pBatch->nBlockers;
+	directionStep(cell.direction, &dRow, &dCol);
+	cell.row += dRow;
+	cell.col += dCol;
+
+	while (isOpen)
+	{
+		int isVertical = (cell.direction == DIR_UP || cell.direction == DIR_DOWN);
+
+		/* PERF: Jump to the next obstacle (bitboard / SIMD scan) */
+		obstacle = findObstacle(pBatch->pBoard, cell.row, cell.col, cell.direction);
+		while ((isVertical ? cell.row : cell.col) != obstacle)
+		{
+			addFireEntry(pBatch, enemyIdx, cell.row, cell.col);
+			cell.row += dRow;
+			cell.col += dCol;
+		}
+
+		marker = getCell(pBatch->pBoard, cell.row, cell.col);
+		blockerIdx = lookupCellHash(pBatch->pEnemyCells, 
+										(long) cell.row * pBatch->pBoard->cols + cell.col, -1);
+
+		if (blockerIdx != -1 && blockerIdx != enemyIdx)
+		{
+			/* The fire goes on once the blocker is destroyed */
+			addFireEntry(pBatch, enemyIdx, cell.row, cell.col);
+			addBlocker(pBatch, blockerIdx);
+			cell.row += dRow;
+			cell.col += dCol;
+		}
+		else if (pBatch->isMirrorFire && 
+					(marker == MARKER_FACE_BMIRROR || marker == MARKER_FACE_FMIRROR))
+		{
+			cell.direction = reflectDirection(marker, cell.direction);
+			directionStep(cell.direction, &dRow, &dCol);
+			cell.row += dRow;
+			cell.col += dCol;
+		}
+		else
+		{
+			/* border, a mirror (straight fire) or the enemy itself */
+			isOpen = FALSE;
+		}
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Whether an enemy still alive stands on the line of fire before the
+ * cell.
+ *
+ * @param pBatch tank batch object.
+ * @param aIsAlive enemy flags of the instance.
+ * @param enemyIdx index of the enemy firing.
+ * @param nBefore number of blockers before the cell.
+ * @return int TRUE if blocked.
+ */
+static int isFireBlocked(const TankBatch* pBatch, const char* aIsAlive, int enemyIdx, int nBefore)
+{
+	int i = pBatch->aiBlockerStart[enemyIdx];
+	int end = i + nBefore;
+
+	while (i < end && !aIsAlive[pBatch->aiBlockers[i]])
+		i++;
+
+	return (i < end);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Whether an enemy of the instance fires on the cell.
+ *
+ * @param pBatch tank batch object.
+ * @param aIsAlive enemy flags of the instance.
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ * @return int TRUE if fired at.
+ */
+static int isFiredAt(const TankBatch* pBatch, const char* aIsAlive, int row, int col)
+{
+	int isFired = FALSE;
+	int entry = lookupCellHash(pBatch->pFireCells, (long) row * pBatch->pBoard->cols + col, -1);
+
+	while (!isFired && entry != -1)
+	{
+		int enemyIdx = pBatch->aiEntryEnemy[entry];
+
+		isFired = aIsAlive[enemyIdx] && 
+					!isFireBlocked(pBatch, aIsAlive, enemyIdx, pBatch->aiEntryBlockers[entry]);
+		entry = pBatch->aiEntryNext[entry];
+	}
+
+	return isFired;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Whether the player of the instance can move to the cell: empty, or
+ * the cell of a destroyed enemy.
+ *
+ * @param pBatch tank batch object.
+ * @param aIsAlive enemy flags of the instance.
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ * @return int TRUE if free.
+ */
+static int isCellFree(const TankBatch* pBatch, const char* aIsAlive, int row, int col)
+{
+	char marker = getCell(pBatch->pBoard, row, col);
+	int enemyIdx = (marker == MARKER_EMPTY) ? -1 : 
+			lookupCellHash(pBatch->pEnemyCells, (long) row * pBatch->pBoard->cols + col, -1);
+
+	return (marker == MARKER_EMPTY) || (enemyIdx != -1 && !aIsAlive[enemyIdx]);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Whether the cell (row, col) is on the leg of a bullet, from the 
+ * bullet cell up to the obstacle (excluded).
+ *
+ * @param pCell bullet cell and direction.
+ * @param obstacle row (up/down) or column (left/right) index of the obstacle.
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ * @return int TRUE if on the leg.
+ */
+static int isOnLeg(const GameObj* pCell, int obstacle, int row, int col)
+{
+	int isVertical = (pCell->direction == DIR_UP || pCell->direction == DIR_DOWN);
+	int from = isVertical ? pCell->row : pCell->col;
+	int at = isVertical ? row : col;
+	int isInLine = isVertical ? (col == pCell->col) : (row == pCell->row);
+	int lo = (from < obstacle) ? from : obstacle + 1;
+	int hi = (from < obstacle) ? obstacle - 1 : from;
+
+	return isInLine && BETWEEN(lo, hi, at);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Fly the shot of the player of the instance until it lands. The 
+ * player is not on the shared board, the legs are checked against it.
+ *
+ * @param pBatch tank batch object.
+ * @param instanceIdx index of the instance.
+ * @return GameStatus game status. Refer to macros.h for game status.
+ */
+static GameStatus resolvePlayerShot(TankBatch* pBatch, int instanceIdx)
+{
+	GameStatus gameStatus = PROGRESSING;
+	char* aIsAlive = pBatch->aIsAlive + (long) instanceIdx * pBatch->nEnemies;
+	int row = pBatch->aiRows[instanceIdx], col = pBatch->aiCols[instanceIdx];
+	int dRow, dCol, obstacle, enemyIdx;
+	int isFlying = TRUE;
+	GameObj cell;
+	char marker;
+
+	updateObj(&cell, row, col, pBatch->acDirections[instanceIdx]);
+	directionStep(cell.direction, &dRow, &dCol);
+	cell.row += dRow;
+	cell.col += dCol;
+
+	while (isFlying)
+	{
+		int isVertical = (cell.direction == DIR_UP || cell.direction == DIR_DOWN);
+		obstacle = findObstacle(pBatch->pBoard, cell.row, cell.col, cell.direction);
+
+		if (isOnLeg(&cell, obstacle, row, col))
+		{
+			/* back on the player, after the mirrors */
+			gameStatus = PLAYER_HIT;
+			isFlying = FALSE;
+		}
+		else
+		{
+			cell.row = isVertical ? obstacle : cell.row;
+			cell.col = isVertical ? cell.col : obstacle;
+			marker = getCell(pBatch->pBoard, cell.row, cell.col);
+			enemyIdx = lookupCellHash(pBatch->pEnemyCells, 
+										(long) cell.row * pBatch->pBoard->cols + cell.col, -1);
+
+			if (enemyIdx != -1 && aIsAlive[enemyIdx])
+			{
+				aIsAlive[enemyIdx] = FALSE;
+				pBatch->aiAlive[instanceIdx]--;
+				gameStatus = (pBatch->aiAlive[instanceIdx] > 0) ? PROGRESSING : ENEMY_HIT;
+				isFlying = FALSE;
+			}
+			else if (enemyIdx != -1 && cell.row == row && cell.col == col)
+			{
+				/* back on the player, standing on a destroyed enemy's cell */
+				gameStatus = PLAYER_HIT;
+				isFlying = FALSE;
+			}
+			else if (enemyIdx != -1)
+			{
+				/* destroyed enemy, off the board of the instance */
+				cell.row += dRow;
+				cell.col += dCol;
+			}
+			else if (marker == MARKER_FACE_BMIRROR || marker == MARKER_FACE_FMIRROR)
+			{
+				cell.direction = reflectDirection(marker, cell.direction);
+				directionStep(cell.direction, &dRow, &dCol);
+				cell.row += dRow;
+				cell.col += dCol;
+			}
+			else
+			{
+				/* hitting border */
+				isFlying = FALSE;
+			}
+		}
+	}
+
+	return gameStatus;
+}
+
+/**************************************************************************************************/
+/* Tank Batch Managment Methods											    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Create a batch of games of the level loaded in the core. The 
+ * instances start from the current state of the core.
+ *
+ * @param pCore tank core object, with a level loaded.
+ * @param nInstances number of games in the batch.
+ * @return TankBatch* tank batch object.
+ */
+TankBatch* createTankBatch(const TankCore* pCore, int nInstances)
+{
+	int i;
+	GameObj enemy;
+	const EnemySet* pEnemies = pCore->oRP.pEnemies;
+	const MapInfo* pMapInfo = pCore->oRP.pMapInfo;
+	TankBatch* pBatch = (TankBatch*) malloc(sizeof(TankBatch));
+
+	assert(pCore->isLoaded);
+
+	/* Level: mirrors and every enemy, the destroyed ones are blockers of no instance */
+	pBatch->nEnemies = pEnemies->nEnemies;
+	pBatch->isMirrorFire = pCore->isMirrorFire;
+	pBatch->pBoard = createMap(pMapInfo->rows, pMapInfo->cols);
+	pBatch->pEnemyCells = createCellHash(CELL_HASH_INIT_CAPACITY);
+	resetMap(pBatch->pBoard);
+	placeMirrors(pBatch->pBoard, pCore->oRP.pMirrorList);
+
+	for (i = 0; i < pBatch->nEnemies; i++)
+	{
+		getEnemy(pEnemies, i, &enemy);
+		placeObj(pBatch->pBoard, &enemy);
+		insertCellHash(pBatch->pEnemyCells, (long) enemy.row * pMapInfo->cols + enemy.col, i);
+	}
+
+	memset(pBatch->acKeyDirections, 0, sizeof(pBatch->acKeyDirections));
+	pBatch->acKeyDirections[(unsigned char) KEY_UP] = DIR_UP;
+	pBatch->acKeyDirections[(unsigned char) KEY_DOWN] = DIR_DOWN;
+	pBatch->acKeyDirections[(unsigned char) KEY_LEFT] = DIR_LEFT;
+	pBatch->acKeyDirections[(unsigned char) KEY_RIGHT] = DIR_RIGHT;
+
+	/* Lines of fire, shared by the instances */
+	pBatch->pFireCells = createCellHash(CELL_HASH_INIT_CAPACITY);
+	pBatch->entryCapacity = BATCH_INIT_ENTRY_CAPACITY;
+	pBatch->aiEntryEnemy = (int*) malloc(sizeof(int) * pBatch->entryCapacity);
+	pBatch->aiEntryBlockers = (int*) malloc(sizeof(int) * pBatch->entryCapacity);
+	pBatch->aiEntryNext = (int*) malloc(sizeof(int) * pBatch->entryCapacity);
+	pBatch->nEntries = 0;
+	pBatch->blockerCapacity = BATCH_INIT_ENTRY_CAPACITY;
+	pBatch->aiBlockers = (int*) malloc(sizeof(int) * pBatch->blockerCapacity);
+	pBatch->aiBlockerStart = (int*) malloc(sizeof(int) * (pBatch->nEnemies + 1));
+	pBatch->nBlockers = 0;
+
+	for (i = 0; i < pBatch->nEnemies; i++)
+	{
+		getEnemy(pEnemies, i, &enemy);
+		collectEnemyFire(pBatch, i, &enemy);
+	}
+	pBatch->aiBlockerStart[pBatch->nEnemies] = pBatch->nBlockers;
+
+	/* Start state */
+	pBatch->oStPlayer = pCore->player;
+	pBatch->aStIsAlive = (char*) malloc(sizeof(char) * (pBatch->nEnemies + 1));
+	memcpy(pBatch->aStIsAlive, pEnemies->aIsAlive, sizeof(char) * pBatch->nEnemies);
+	pBatch->nStAlive = pEnemies->nAlive;
+
+	/* Instances */
+	pBatch->nInstances = nInstances;
+	pBatch->aiRows = (int*) malloc(sizeof(int) * nInstances);
+	pBatch->aiCols = (int*) malloc(sizeof(int) * nInstances);
+	pBatch->acDirections = (char*) malloc(sizeof(char) * nInstances);
+	pBatch->aGameStatus = (GameStatus*) malloc(sizeof(GameStatus) * nInstances);
+	pBatch->aiSteps = (int*) malloc(sizeof(int) * nInstances);
+	pBatch->aiAlive = (int*) malloc(sizeof(int) * nInstances);
+	pBatch->aIsAlive = (char*) malloc(sizeof(char) * ((long) nInstances * pBatch->nEnemies + 1));
+	pBatch->aiNewRows = (int*) malloc(sizeof(int) * nInstances);
+	pBatch->aiNewCols = (int*) malloc(sizeof(int) * nInstances);
+	pBatch->aIsMoving = (char*) malloc(sizeof(char) * nInstances);
+
+	resetTankBatch(pBatch);
+
+	return pBatch;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy the tank batch object. Call free().
+ *
+ * @param pBatch tank batch object.
+ */
+void destroyTankBatch(TankBatch* pBatch)
+{
+	free(pBatch->aiRows);
+	free(pBatch->aiCols);
+	free(pBatch->acDirections);
+	free(pBatch->aGameStatus);
+	free(pBatch->aiSteps);
+	free(pBatch->aiAlive);
+	free(pBatch->aIsAlive);
+	free(pBatch->aiNewRows);
+	free(pBatch->aiNewCols);
+	free(pBatch->aIsMoving);
+
+	destroyMap(pBatch->pBoard);
+	destroyCellHash(pBatch->pEnemyCells);
+	destroyCellHash(pBatch->pFireCells);
+	free(pBatch->aStIsAlive);
+	free(pBatch->aiEntryEnemy);
+	free(pBatch->aiEntryBlockers);
+	free(pBatch->aiEntryNext);
+	free(pBatch->aiBlockers);
+	free(pBatch->aiBlockerStart);
+	free(pBatch);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Start a new episode on every instance.
+ *
+ * @param pBatch tank batch object.
+ */
+void resetTankBatch(TankBatch* pBatch)
+{
+	int i;
+
+	for (i = 0; i < pBatch->nInstances; i++)
+		resetBatchInstance(pBatch, i);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Start a new episode on the instance, the others go on.
+ *
+ * @param pBatch tank batch object.
+ * @param instanceIdx index of the instance.
+ */
+void resetBatchInstance(TankBatch* pBatch, int instanceIdx)
+{
+	char* aIsAlive = pBatch->aIsAlive + (long) instanceIdx * pBatch->nEnemies;
+
+	pBatch->aiRows[instanceIdx] = pBatch->oStPlayer.row;
+	pBatch->aiCols[instanceIdx] = pBatch->oStPlayer.col;
+	pBatch->acDirections[instanceIdx] = pBatch->oStPlayer.direction;
+	pBatch->aGameStatus[instanceIdx] = PROGRESSING;
+	pBatch->aiSteps[instanceIdx] = 0;
+	pBatch->aiAlive[instanceIdx] = pBatch->nStAlive;
+	memcpy(aIsAlive, pBatch->aStIsAlive, sizeof(char) * pBatch->nEnemies);
+}
+
+/**************************************************************************************************/
+/* Tank Batch Simulation Methods										    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Apply one action per instance, the same as stepTankCore() on each
+ * game: a move key (w/a/s/d), KEY_SHOOT, or any other key to wait. The 
+ * instances whose episode is over do not change.
+ *
+ * @param pBatch tank batch object.
+ * @param acActions action of each instance.
+ */
+void stepTankBatch(TankBatch* pBatch, const char* acActions)
+{
+	int i;
+	int n = pBatch->nInstances;
+	int rows = pBatch->pBoard->rows, cols = pBatch->pBoard->cols;
+
+	/* PERF: Move rules (refer performTurnOrMove()) and bounds of the whole batch in one 
+	   branch-free loop over the arrays */
+	for (i = 0; i < n; i++)
+	{
+		char direction = pBatch->acKeyDirections[(unsigned char) acActions[i]];
+		int isActive = (pBatch->aGameStatus[i] == PROGRESSING);
+		int isTurning = isActive && direction && (direction != pBatch->acDirections[i]);
+		int isStepping = isActive && direction && !isTurning;
+		int row = pBatch->aiRows[i] + isStepping * ((direction == DIR_DOWN) - (direction == DIR_UP));
+		int col = pBatch->aiCols[i] + isStepping * ((direction == DIR_RIGHT) - (direction == DIR_LEFT));
+
+		pBatch->acDirections[i] = isTurning ? direction : pBatch->acDirections[i];
+		pBatch->aiNewRows[i] = row;
+		pBatch->aiNewCols[i] = col;
+		pBatch->aIsMoving[i] = isStepping && BETWEEN(1, rows - 2, row) && BETWEEN(1, cols - 2, col);
+		pBatch->aiSteps[i] += isActive;
+	}
+
+	/* The cell must be free, moving into a line of fire ends the episode */
+	for (i = 0; i < n; i++)
+	{
+		const char* aIsAlive = pBatch->aIsAlive + (long) i * pBatch->nEnemies;
+
+		if (pBatch->aIsMoving[i] && 
+				isCellFree(pBatch, aIsAlive, pBatch->aiNewRows[i], pBatch->aiNewCols[i]))
+		{
+			pBatch->aiRows[i] = pBatch->aiNewRows[i];
+			pBatch->aiCols[i] = pBatch->aiNewCols[i];
+
+			if (isFiredAt(pBatch, aIsAlive, pBatch->aiRows[i], pBatch->aiCols[i]))
+				pBatch->aGameStatus[i] = PLAYER_HIT;
+		}
+	}
+
+	/* Shots fly until they land */
+	for (i = 0; i < n; i++)
+	{
+		if (pBatch->aGameStatus[i] == PROGRESSING && acActions[i] == KEY_SHOOT)
+			pBatch->aGameStatus[i] = resolvePlayerShot(pBatch, i);
+	}
+}
@@ -0,0 +1,55 @@
+#ifndef TANKBATCH_H
+#define TANKBATCH_H
+
+#include "map.h"
+#include "macros.h"
+#include "cellhash.h"
+#include "tankcore.h"
+
+/* Object Definitions */
+typedef struct TankBatch
+{
+	/* Instances: structure of arrays, one entry per instance */
+	int nInstances;
+	int* aiRows;				/* player of each instance */
+	int* aiCols;
+	char* acDirections;
+	GameStatus* aGameStatus;	/* PROGRESSING until the episode of the instance is over */
+	int* aiSteps;
+	int* aiAlive;				/* enemies left */
+	char* aIsAlive;				/* nEnemies flags per instance, instance after instance */
+	int* aiNewRows;				/* scratch: cell each instance moves to */
+	int* aiNewCols;
+	char* aIsMoving;
+
+	/* Level: shared and read only while stepping */
+	MapInfo* pBoard;			/* mirrors and every enemy of the level, no player */
+	int nEnemies;
+	int isMirrorFire;
+	GameObj oStPlayer;			/* start state of the instances */
+	char* aStIsAlive;
+	int nStAlive;
+	char acKeyDirections[256];	/* move key -> direction, 0 if not a move */
+	CellHash* pEnemyCells;		/* cell -> enemy index, dead or alive */
+	CellHash* pFireCells;		/* cell -> first line of fire entry on the cell */
+	int* aiEntryEnemy;			/* entries: enemy firing on the cell */
+	int* aiEntryBlockers;		/* entries: blockers of the enemy before the cell */
+	int* aiEntryNext;			/* entries: next entry on the cell, -1 at the end */
+	int nEntries;
+	int entryCapacity;
+	int* aiBlockers;			/* enemies on each line of fire, in flight order */
+	int* aiBlockerStart;		/* first blocker of each enemy (nEnemies + 1 offsets) */
+	int nBlockers;
+	int blockerCapacity;
+} TankBatch;
+
+/* Tank Batch Managment Methods */
+TankBatch* createTankBatch(const TankCore* pCore, int nInstances);
+void destroyTankBatch(TankBatch* pBatch);
+void resetTankBatch(TankBatch* pBatch);
+void resetBatchInstance(TankBatch* pBatch, int instanceIdx);
+
+/* Tank Batch Simulation Methods */
+void stepTankBatch(TankBatch* pBatch, const char* acActions);
+
+#endif
@@ -0,0 +1,240 @@
+/* PURPOSE: Tank game core: the simulation behind a reset(level) / step(action)
+ * interface, for bots and tools. Nothing is printed or slept, a shot is
+ * resolved within the step that fires it.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+/* Local Includes */
+#include "tankcore.h"
+#include "util.h"
+#include "envinit.h"
+#include "gamesim.h"
+#include "threat.h"
+#include "enemy.h"
+#include "bullet.h"
+#include "zobrist.h"
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Destroy the game elements of the loaded level, if any.
+ * 
+ * @param pCore tank core object.
+ */
+static void unloadLevel(TankCore* pCore)
+{
+	if (pCore->isLoaded)
+	{
+		destroyThreatMask(pCore->oRP.pThreat);
+		destroyZobristHash(pCore->oRP.pZobrist);
+		destroyBulletPool(pCore->oRP.pBullets);
+		exitGame(pCore->oRP.pMapInfo, pCore->oRP.pEnemies, 
+					pCore->oRP.pMirrorList, pCore->oRP.pLogList);
+		pCore->isLoaded = FALSE;
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Fly the bullets in flight until they all land or the game is over.
+ * 
+ * @param pCore tank core object.
+ * @param gameStatus game status before the ticks.
+ * @return GameStatus game status. Refer to macros.h for game status.
+ */
+static GameStatus resolveShots(TankCore* pCore, GameStatus gameStatus)
+{
+	RefreshMapParam* pRP = &(pCore->oRP);
+
+	while (gameStatus == PROGRESSING && pRP->pBullets->nBullets > 0)
+	{
+		gameStatus = advanceTick(pRP);
+		pCore->nTicks++;
+	}
+
+	return gameStatus;
+}
+
+/**************************************************************************************************/
+/* Tank Core Managment Methods											    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Create a tank core object, with no level loaded.
+ * 
+ * @return TankCore* tank core object.
+ */
+TankCore* createTankCore(void)
+{
+	TankCore* pCore = (TankCore*) malloc(sizeof(TankCore));
+
+	pCore->gameStatus = PROGRESSING;
+	pCore->nSteps = 0;
+	pCore->nTicks = 0;
+	pCore->isMirrorFire = FALSE;
+	pCore->isLoaded = FALSE;
+	pCore->loadError = LOAD_OK;
+
+	return pCore;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy the tank core object and its level.
+ * 
+ * @param pCore tank core object.
+ */
+void destroyTankCore(TankCore* pCore)
+{
+	unloadLevel(pCore);
+	free(pCore);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Load a level (a config file of the game) and start a new episode. 
+ * The previous level is dropped. An invalid level is not reported, loadError
+ * tells why it was rejected (refer loadErrorMessage()).
+ * 
+ * @param pCore tank core object.
+ * @param zLevelFileName level file name (config file).
+ * @param pOptions game options, only isMirrorFire is used.
+ * @return int success status.
+ */
+int resetTankCore(TankCore* pCore, const char* zLevelFileName, const GameOptions* pOptions)
+{
+	MapInfo* pMapInfo = NULL;
+	EnemySet* pEnemies = NULL;
+	LinkedList* pMirrorList = NULL;
+	LinkedList* pLogList = NULL;
+
+	unloadLevel(pCore);
+	pCore->gameStatus = PROGRESSING;
+	pCore->nSteps = 0;
+	pCore->nTicks = 0;
+	pCore->isMirrorFire = pOptions->isMirrorFire;
+	pCore->isLoaded = initGame(zLevelFileName, &pMapInfo, &pEnemies, &(pCore->player), 
+											&pMirrorList, &pLogList, &(pCore->loadError));
+	if (pCore->isLoaded)
+	{
+		/* The maps are never logged, the log list stays empty */
+		packRefreshParams(&(pCore->oRP), pMapInfo, pEnemies, &(pCore->player), 
+							createBulletPool(), pMirrorList, pLogList, NULL, FALSE);
+		pCore->oRP.isHeadless = TRUE;
+		pCore->oRP.pThreat = createThreatMask(pMapInfo, pEnemies, pOptions->isMirrorFire);
+		pCore->oRP.pZobrist = createZobristHash(pMapInfo, pEnemies, pMirrorList,
+													pOptions->isMirrorFire);
+		resetZobristHash(pCore->oRP.pZobrist, pEnemies, &(pCore->player));
+		pCore->oStPlayer = pCore->player;
+		rebuildMap(&(pCore->oRP));
+	}
+
+	return pCore->isLoaded;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Start a new episode of the loaded level, without reading the level
+ * file again.
+ * 
+ * @param pCore tank core object, with a level loaded.
+ */
+void restartTankCore(TankCore* pCore)
+{
+	assert(pCore->isLoaded);
+
+	pCore->player = pCore->oStPlayer;
+	pCore->gameStatus = PROGRESSING;
+	pCore->nSteps = 0;
+	pCore->nTicks = 0;
+	reviveEnemies(pCore->oRP.pEnemies);
+	clearBullets(pCore->oRP.pBullets);
+	invalidateThreatMask(pCore->oRP.pThreat);
+	resetZobristHash(pCore->oRP.pZobrist, pCore->oRP.pEnemies, &(pCore->player));
+	rebuildMap(&(pCore->oRP));
+}
+
+/**************************************************************************************************/
+/* Tank Core Simulation Methods											    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Apply an action and fly the shots it leads to (the player's and the
+ * enemy's) until they land. Once the episode is over the steps change nothing.
+ * 
+ * @param pCore tank core object, with a level loaded.
+ * @param action move key (w/a/s/d) or KEY_SHOOT. Any other key just waits.
+ * @param pObservation export variable for the observation after the step, 
+ * NULL if not needed.
+ * @return GameStatus game status. Refer to macros.h for game status.
+ */
+GameStatus stepTankCore(TankCore* pCore, char action, TankObservation* pObservation)
+{
+	RefreshMapParam* pRP = &(pCore->oRP);
+	GameStatus gameStatus = pCore->gameStatus;
+	GameObj oldPlayer = pCore->player;
+
+	assert(pCore->isLoaded);
+
+	if (gameStatus == PROGRESSING)
+	{
+		switch(action)
+		{
+			case KEY_UP:
+			case KEY_DOWN:
+			case KEY_LEFT:
+			case KEY_RIGHT:
+				gameStatus = turnOrMove(pRP, action);
+
+				/* PERF: Only the player's cells change, no need to rebuild the whole map */
+				setCell(pRP->pMapInfo, oldPlayer.row, oldPlayer.col, MARKER_EMPTY);
+				placeObj(pRP->pMapInfo, &(pCore->player));
+			break;
+
+			case KEY_SHOOT:
+				gameStatus = shoot(pRP);
+			break;
+
+			default:
+				/* no action, the step passes */
+			break;
+		}
+
+		gameStatus = resolveShots(pCore, gameStatus);
+
+		/* The map is already up to date while the game goes on (getHitStatus() rebuilds it
+		 * after a kill), only the last enemy destroyed is still on it */
+		if (gameStatus != PROGRESSING)
+			rebuildMap(pRP);
+
+		pCore->gameStatus = gameStatus;
+		pCore->nSteps++;
+	}
+
+	if (pObservation)
+		observeTankCore(pCore, pObservation);
+
+	return gameStatus;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Observation of the current state of the episode.
+ * 
+ * @param pCore tank core object, with a level loaded.
+ * @param pObservation export variable for the observation.
+ */
+void observeTankCore(const TankCore* pCore, TankObservation* pObservation)
+{
+	pObservation->pMapInfo = pCore->oRP.pMapInfo;
+	pObservation->player = pCore->player;
+	pObservation->nAlive = pCore->oRP.pEnemies->nAlive;
+	pObservation->nSteps = pCore->nSteps;
+	pObservation->stateHash = pCore->oRP.pZobrist->hash;
+}
@@ -0,0 +1,41 @@
+#ifndef TANKCORE_H
+#define TANKCORE_H
+
+#include <stdint.h>
+#include "map.h"
+#include "macros.h"
+
+/* Object Definitions */
+typedef struct TankObservation
+{
+	const MapInfo* pMapInfo;	/* board after the step (read with getCell()), owned by the core */
+	GameObj player;
+	int nAlive;					/* enemies left */
+	int nSteps;					/* steps since the reset */
+	uint64_t stateHash;			/* zobrist hash of the player, enemies alive and level */
+} TankObservation;
+
+typedef struct TankCore
+{
+	RefreshMapParam oRP;		/* game elements of the loaded level */
+	GameObj player;
+	GameObj oStPlayer;			/* start cell of the player, for restarts */
+	GameStatus gameStatus;		/* PROGRESSING until the episode is over */
+	int nSteps;
+	int nTicks;					/* bullet ticks flown since the reset */
+	int isMirrorFire;			/* enemies bank shots off the mirrors */
+	int isLoaded;				/* a level is loaded */
+	int loadError;				/* why the last level was rejected (LOAD_...), LOAD_OK if loaded */
+} TankCore;
+
+/* Tank Core Managment Methods */
+TankCore* createTankCore(void);
+void destroyTankCore(TankCore* pCore);
+int resetTankCore(TankCore* pCore, const char* zLevelFileName, const GameOptions* pOptions);
+void restartTankCore(TankCore* pCore);
+
+/* Tank Core Simulation Methods */
+GameStatus stepTankCore(TankCore* pCore, char action, TankObservation* pObservation);
+void observeTankCore(const TankCore* pCore, TankObservation* pObservation);
+
+#endif
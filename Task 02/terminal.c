@@ -0,0 +1,70 @@
+/* PURPOSE: Raw (non-canonical) terminal mode of the Tank Game. The keys are
+ * read as soon as they are pressed, without echo.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+#define _DEFAULT_SOURCE
+
+/* Standard Include */
+#include <stdlib.h>
+#include <unistd.h>
+
+/* Local Includes */
+#include "terminal.h"
+#include "macros.h"
+
+/**************************************************************************************************/
+/* Terminal Mode Methods												    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Switch the terminal to raw mode: no line buffering, no echo. The
+ * signal keys (Ctrl-C) still work.
+ *
+ * @return Terminal* terminal object, NULL if stdin is not a terminal.
+ */
+Terminal* enterRawMode(void)
+{
+	struct termios oRaw;
+	Terminal* pTerminal = NULL;
+
+	if (isatty(STDIN_FILENO))
+	{
+		pTerminal = (Terminal*) malloc(sizeof(Terminal));
+		tcgetattr(STDIN_FILENO, &(pTerminal->oSaved));
+		pTerminal->isFooterShown = FALSE;
+		pTerminal->belowFooterRow = 0;
+
+		oRaw = pTerminal->oSaved;
+		oRaw.c_lflag &= ~(ICANON | ECHO);
+		oRaw.c_cc[VMIN] = 1;
+		oRaw.c_cc[VTIME] = 0;
+		tcsetattr(STDIN_FILENO, TCSAFLUSH, &oRaw);
+	}
+
+	return pTerminal;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Whether stdout is a terminal (not a pipe or a file).
+ *
+ * @return int TRUE if terminal.
+ */
+int isTerminalOutput(void)
+{
+	return isatty(STDOUT_FILENO);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Restore the terminal settings and destroy the terminal object. Call 
+ * free().
+ *
+ * @param pTerminal terminal object.
+ */
+void leaveRawMode(Terminal* pTerminal)
+{
+	tcsetattr(STDIN_FILENO, TCSAFLUSH, &(pTerminal->oSaved));
+	free(pTerminal);
+}
@@ -0,0 +1,19 @@
+#ifndef TERMINAL_H
+#define TERMINAL_H
+
+#include <termios.h>
+
+/* Object Definitions */
+typedef struct Terminal
+{
+	struct termios oSaved;	/* settings restored on exit */
+	int isFooterShown;		/* the menu is on the screen as a footer */
+	int belowFooterRow;		/* first screen row below the footer */
+} Terminal;
+
+/* Terminal Mode Methods */
+Terminal* enterRawMode(void);
+void leaveRawMode(Terminal* pTerminal);
+int isTerminalOutput(void);
+
+#endif
@@ -0,0 +1,511 @@
+/* PURPOSE: Precomputed enemy lines of fire (threat mask) of the Tank Game.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Local Includes */
+#include "threat.h"
+#include "macros.h"
+#include "util.h"
+
+/* Trace visit context: the line of fire being collected */
+typedef struct FireContext
+{
+	ThreatMask* pThreat;
+	EnemyFire* pFire;
+} FireContext;
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Set or clear the threat bit of the cell. Allocates the tile if needed.
+ *
+ * @param pThreat threat mask object.
+ * @param key cell key (row * cols + col).
+ * @param isSet whether to set or clear the bit.
+ */
+static void writeThreatBit(ThreatMask* pThreat, long key, int isSet)
+{
+	int row = (int) (key / pThreat->cols), col = (int) (key % pThreat->cols);
+	int tileIdx = MAP_TILE_INDEX(pThreat, row, col);
+	uint64_t bit = BITBOARD_ONE << (col & MAP_TILE_MASK);
+
+	if (isSet && !pThreat->apTiles[tileIdx])
+	{
+		if (pThreat->nUsedTiles == pThreat->tileCapacity)
+		{
+			pThreat->tileCapacity *= 2;
+			pThreat->aiUsedTiles = (int*) realloc(pThreat->aiUsedTiles,
+												sizeof(int) * pThreat->tileCapacity);
+		}
+
+		pThreat->apTiles[tileIdx] = (ThreatTile*) calloc(1, sizeof(ThreatTile));
+		pThreat->aiUsedTiles[pThreat->nUsedTiles++] = tileIdx;
+	}
+
+	if (isSet)
+		pThreat->apTiles[tileIdx]->aRowBits[row & MAP_TILE_MASK] |= bit;
+	else if (pThreat->apTiles[tileIdx])
+		pThreat->apTiles[tileIdx]->aRowBits[row & MAP_TILE_MASK] &= ~bit;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Push the enemy to the front of the chain of the cell.
+ *
+ * @param pThreat threat mask object.
+ * @param pChains chain heads (pSources or pBlockers).
+ * @param key cell key.
+ * @param enemyIdx index of the enemy.
+ */
+static void pushChainEntry(ThreatMask* pThreat, CellHash* pChains, long key, int enemyIdx)
+{
+	int entry = pThreat->freeEntry;
+
+	if (entry != -1)
+	{
+		pThreat->freeEntry = pThreat->aiEntryNext[entry];
+	}
+	else
+	{
+		if (pThreat->nEntries == pThreat->entryCapacity)
+		{
+			pThreat->entryCapacity *= 2;
+			pThreat->aiEntryEnemy = (int*) realloc(pThreat->aiEntryEnemy,
+												sizeof(int) * pThreat->entryCapacity);
+			pThreat->aiEntryNext = (int*) realloc(pThreat->aiEntryNext,
+												sizeof(int) * pThreat->entryCapacity);
+		}
+
+		entry = pThreat->nEntries++;
+	}
+
+	pThreat->aiEntryEnemy[entry] = enemyIdx;
+	pThreat->aiEntryNext[entry] = lookupCellHash(pChains, key, -1);
+	insertCellHash(pChains, key, entry);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Unlink the enemy from the chain of the cell.
+ *
+ * @param pThreat threat mask object.
+ * @param pChains chain heads (pSources or pBlockers).
+ * @param key cell key.
+ * @param enemyIdx index of the enemy.
+ * @return int whether the chain is empty afterwards.
+ */
+static int removeChainEntry(ThreatMask* pThreat, CellHash* pChains, long key, int enemyIdx)
+{
+	int head = lookupCellHash(pChains, key, -1);
+	int prev = -1, entry = head;
+
+	while (entry != -1 && pThreat->aiEntryEnemy[entry] != enemyIdx)
+	{
+		prev = entry;
+		entry = pThreat->aiEntryNext[entry];
+	}
+
+	if (entry != -1)
+	{
+		if (prev == -1)
+			head = pThreat->aiEntryNext[entry];
+		else
+			pThreat->aiEntryNext[prev] = pThreat->aiEntryNext[entry];
+
+		insertCellHash(pChains, key, head);
+		pThreat->aiEntryNext[entry] = pThreat->freeEntry;
+		pThreat->freeEntry = entry;
+	}
+
+	return (head == -1);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Mark the enemy to be recomputed on the next refresh.
+ *
+ * @param pThreat threat mask object.
+ * @param enemyIdx index of the enemy.
+ */
+static void markDirty(ThreatMask* pThreat, int enemyIdx)
+{
+	if (pThreat->aFires[enemyIdx].isValid)
+	{
+		pThreat->aFires[enemyIdx].isValid = FALSE;
+		pThreat->aiDirty[pThreat->nDirty++] = enemyIdx;
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Mark every enemy in the chain of the cell to be recomputed.
+ *
+ * @param pThreat threat mask object.
+ * @param pChains chain heads (pSources or pBlockers).
+ * @param key cell key.
+ */
+static void markChainDirty(ThreatMask* pThreat, const CellHash* pChains, long key)
+{
+	int entry = lookupCellHash(pChains, key, -1);
+
+	while (entry != -1)
+	{
+		markDirty(pThreat, pThreat->aiEntryEnemy[entry]);
+		entry = pThreat->aiEntryNext[entry];
+	}
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Append the cell to the line of fire (trace visit callback).
+ *
+ * @param pContext fire context object.
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ */
+static void appendFireCell(void* pContext, int row, int col)
+{
+	FireContext* pFireCtx = (FireContext*) pContext;
+	EnemyFire* pFire = pFireCtx->pFire;
+
+	if (pFire->nCells == pFire->cellCapacity)
+	{
+		pFire->cellCapacity *= 2;
+		pFire->alCells = (long*) realloc(pFire->alCells, sizeof(long) * pFire->cellCapacity);
+	}
+
+	pFire->alCells[pFire->nCells++] = (long) row * pFireCtx->pThreat->cols + col;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Collect the cells in the enemy line of fire: from the cell in front
+ * of the enemy up to the first obstacle, or along the reflected trace if
+ * mirror fire is enabled. The player does not block the line of fire, it is
+ * where the player could move to.
+ *
+ * @param pThreat threat mask object.
+ * @param pMapInfo map object.
+ * @param pEnemy enemy object.
+ * @param pPlayer player object (the cell the player occupies on the map).
+ * @param pFire export variable for the line of fire.
+ */
+static void collectLineOfFire(ThreatMask* pThreat, const MapInfo* pMapInfo,
+								const GameObj* pEnemy, GameObj* pPlayer, EnemyFire* pFire)
+{
+	int dRow, dCol, obstacle = 0;
+	int isVertical = (pEnemy->direction == DIR_UP || pEnemy->direction == DIR_DOWN);
+	GameObj cell;
+	FireContext fireCtx;
+
+	fireCtx.pThreat = pThreat;
+	fireCtx.pFire = pFire;
+	directionStep(pEnemy->direction, &dRow, &dCol);
+	updateObj(&cell, pEnemy->row + dRow, pEnemy->col + dCol, pEnemy->direction);
+	pFire->oStCell = cell;
+	pFire->nCells = 0;
+
+	if (pThreat->pTraces)
+	{
+		/* PERF: Reflected trace, the legs are memoised until the board changes */
+		traceLine(pThreat->pTraces, pMapInfo, &cell, pPlayer, &appendFireCell, &fireCtx, &cell);
+	}
+	else
+	{
+		/* PERF: Jump to the next obstacle (bitboard / SIMD scan), look through the player */
+		do
+		{
+			obstacle = findObstacle(pMapInfo, cell.row, cell.col, cell.direction);
+
+			while ((isVertical ? cell.row : cell.col) != obstacle)
+			{
+				appendFireCell(&fireCtx, cell.row, cell.col);
+				cell.row += dRow;
+				cell.col += dCol;
+			}
+
+			if (pPlayer && cell.row == pPlayer->row && cell.col == pPlayer->col)
+			{
+				appendFireCell(&fireCtx, cell.row, cell.col);
+				cell.row += dRow;
+				cell.col += dCol;
+				obstacle = -1;
+			}
+		} while (obstacle == -1);
+	}
+
+	pFire->blockCell = (long) cell.row * pThreat->cols + cell.col;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Remove the cached line of fire of the enemy from the mask.
+ *
+ * @param pThreat threat mask object.
+ * @param enemyIdx index of the enemy.
+ */
+static void removeEnemyFire(ThreatMask* pThreat, int enemyIdx)
+{
+	int i;
+	EnemyFire* pFire = &(pThreat->aFires[enemyIdx]);
+
+	for (i = 0; i < pFire->nCells; i++)
+	{
+		if (removeChainEntry(pThreat, pThreat->pSources, pFire->alCells[i], enemyIdx))
+			writeThreatBit(pThreat, pFire->alCells[i], FALSE);
+	}
+
+	if (pFire->blockCell != -1)
+		removeChainEntry(pThreat, pThreat->pBlockers, pFire->blockCell, enemyIdx);
+
+	pFire->nCells = 0;
+	pFire->blockCell = -1;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Add the cached line of fire of the enemy to the mask.
+ *
+ * @param pThreat threat mask object.
+ * @param enemyIdx index of the enemy.
+ */
+static void addEnemyFire(ThreatMask* pThreat, int enemyIdx)
+{
+	int i;
+	EnemyFire* pFire = &(pThreat->aFires[enemyIdx]);
+
+	for (i = 0; i < pFire->nCells; i++)
+	{
+		pushChainEntry(pThreat, pThreat->pSources, pFire->alCells[i], enemyIdx);
+		writeThreatBit(pThreat, pFire->alCells[i], TRUE);
+	}
+
+	pushChainEntry(pThreat, pThreat->pBlockers, pFire->blockCell, enemyIdx);
+}
+
+/**************************************************************************************************/
+/* Threat Mask Managment Methods										    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Create an empty threat mask object for the map and the enemies. All
+ * the lines of fire are computed on the first refreshThreatMask().
+ *
+ * @param pMapInfo map object.
+ * @param pEnemies enemy set object.
+ * @param isMirrorFire whether the enemies bank shots off the mirrors.
+ * @return ThreatMask* threat mask object.
+ */
+ThreatMask* createThreatMask(const MapInfo* pMapInfo, const EnemySet* pEnemies, int isMirrorFire)
+{
+	int i;
+	ThreatMask* pThreat = (ThreatMask*) malloc(sizeof(ThreatMask));
+
+	pThreat->rows = pMapInfo->rows;
+	pThreat->cols = pMapInfo->cols;
+	pThreat->tileCols = pMapInfo->tileCols;
+	pThreat->apTiles = (ThreatTile**) calloc((size_t) pMapInfo->tileRows * pMapInfo->tileCols,
+																		sizeof(ThreatTile*));
+	pThreat->tileCapacity = THREAT_INIT_TILE_CAPACITY;
+	pThreat->aiUsedTiles = (int*) malloc(sizeof(int) * pThreat->tileCapacity);
+	pThreat->nUsedTiles = 0;
+
+	pThreat->pSources = createCellHash(CELL_HASH_INIT_CAPACITY);
+	pThreat->pBlockers = createCellHash(CELL_HASH_INIT_CAPACITY);
+	pThreat->entryCapacity = THREAT_INIT_ENTRY_CAPACITY;
+	pThreat->aiEntryEnemy = (int*) malloc(sizeof(int) * pThreat->entryCapacity);
+	pThreat->aiEntryNext = (int*) malloc(sizeof(int) * pThreat->entryCapacity);
+	pThreat->nEntries = 0;
+	pThreat->freeEntry = -1;
+
+	pThreat->nEnemies = pEnemies->nEnemies;
+	pThreat->aFires = (EnemyFire*) malloc(sizeof(EnemyFire) * (pEnemies->nEnemies + 1));
+	pThreat->aiDirty = (int*) malloc(sizeof(int) * (pEnemies->nEnemies + 1));
+	pThreat->nDirty = 0;
+
+	for (i = 0; i < pThreat->nEnemies; i++)
+	{
+		pThreat->aFires[i].cellCapacity = THREAT_INIT_FIRE_CAPACITY;
+		pThreat->aFires[i].alCells = (long*) malloc(sizeof(long) * THREAT_INIT_FIRE_CAPACITY);
+		pThreat->aFires[i].nCells = 0;
+		pThreat->aFires[i].blockCell = -1;
+		pThreat->aFires[i].isValid = TRUE;
+		markDirty(pThreat, i);
+	}
+
+	pThreat->pTraces = isMirrorFire ? createTraceMemo(pMapInfo) : NULL;
+
+	return pThreat;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy the threat mask object. Call free().
+ *
+ * @param pThreat threat mask object.
+ */
+void destroyThreatMask(ThreatMask* pThreat)
+{
+	int i;
+
+	for (i = 0; i < pThreat->nUsedTiles; i++)
+		free(pThreat->apTiles[pThreat->aiUsedTiles[i]]);
+
+	for (i = 0; i < pThreat->nEnemies; i++)
+		free(pThreat->aFires[i].alCells);
+
+	if (pThreat->pTraces)
+		destroyTraceMemo(pThreat->pTraces);
+
+	destroyCellHash(pThreat->pSources);
+	destroyCellHash(pThreat->pBlockers);
+	free(pThreat->aiEntryEnemy);
+	free(pThreat->aiEntryNext);
+	free(pThreat->aFires);
+	free(pThreat->aiDirty);
+	free(pThreat->apTiles);
+	free(pThreat->aiUsedTiles);
+	free(pThreat);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Invalidate all the lines of fire, they are recomputed on the next
+ * refreshThreatMask().
+ *
+ * @param pThreat threat mask object.
+ */
+void invalidateThreatMask(ThreatMask* pThreat)
+{
+	int i;
+
+	for (i = 0; i < pThreat->nEnemies; i++)
+		markDirty(pThreat, i);
+
+	if (pThreat->pTraces)
+		invalidateTraceMemo(pThreat->pTraces);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Invalidate the line of fire of an enemy (e.g. the enemy is destroyed).
+ *
+ * @param pThreat threat mask object.
+ * @param enemyIdx index of the enemy.
+ */
+void invalidateEnemyFire(ThreatMask* pThreat, int enemyIdx)
+{
+	markDirty(pThreat, enemyIdx);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief The cell has changed on the board. Invalidate only the lines of fire
+ * that run through or stop at the cell.
+ *
+ * @param pThreat threat mask object.
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ */
+void invalidateThreatAt(ThreatMask* pThreat, int row, int col)
+{
+	long key = (long) row * pThreat->cols + col;
+
+	markChainDirty(pThreat, pThreat->pSources, key);
+	markChainDirty(pThreat, pThreat->pBlockers, key);
+
+	/* PERF: Only the memoised legs stopped at the cell are stale */
+	if (pThreat->pTraces)
+		invalidateTraceAt(pThreat->pTraces, row, col);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Recompute the invalidated lines of fire. The map must hold the player
+ * at pPlayer.
+ *
+ * @param pThreat threat mask object.
+ * @param pMapInfo map object.
+ * @param pEnemies enemy set object.
+ * @param pPlayer player object.
+ */
+void refreshThreatMask(ThreatMask* pThreat, const MapInfo* pMapInfo,
+							const EnemySet* pEnemies, GameObj* pPlayer)
+{
+	GameObj enemy;
+
+	/* PERF: Only the dirty enemies, the others keep their cached line of fire */
+	while (pThreat->nDirty > 0)
+	{
+		int enemyIdx = pThreat->aiDirty[--pThreat->nDirty];
+
+		removeEnemyFire(pThreat, enemyIdx);
+		if (pEnemies->aIsAlive[enemyIdx])
+		{
+			getEnemy(pEnemies, enemyIdx, &enemy);
+			collectLineOfFire(pThreat, pMapInfo, &enemy, pPlayer, &(pThreat->aFires[enemyIdx]));
+			addEnemyFire(pThreat, enemyIdx);
+		}
+
+		pThreat->aFires[enemyIdx].isValid = TRUE;
+	}
+}
+
+/**************************************************************************************************/
+/* Threat Mask Query Methods											    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Whether the cell is in any enemy line of fire. O(1) lookup.
+ *
+ * @param pThreat threat mask object.
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ * @return int TRUE if threatened.
+ */
+int isThreatened(const ThreatMask* pThreat, int row, int col)
+{
+	int isThreat = FALSE;
+
+	if (BETWEEN(0, pThreat->rows - 1, row) && BETWEEN(0, pThreat->cols - 1, col))
+	{
+		ThreatTile* pTile = pThreat->apTiles[MAP_TILE_INDEX(pThreat, row, col)];
+		isThreat = pTile &&
+			((pTile->aRowBits[row & MAP_TILE_MASK] >> (col & MAP_TILE_MASK)) & 1);
+	}
+
+	return isThreat;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief The enemy firing on the cell. Only the enemies whose line of fire
+ * covers the cell are looked at.
+ *
+ * @param pThreat threat mask object.
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ * @param pBulletStCell if found, export variable for the start cell of the bullet.
+ * @return int index of the enemy, -1 if the cell is not threatened.
+ */
+int findThreatSource(const ThreatMask* pThreat, int row, int col, GameObj* pBulletStCell)
+{
+	int enemyIdx = -1;
+
+	/* PERF: Bit test first, the hash is looked up on a threatened cell only */
+	if (isThreatened(pThreat, row, col))
+	{
+		int entry = lookupCellHash(pThreat->pSources, (long) row * pThreat->cols + col, -1);
+		enemyIdx = (entry != -1) ? pThreat->aiEntryEnemy[entry] : -1;
+	}
+
+	if (enemyIdx != -1)
+		*pBulletStCell = pThreat->aFires[enemyIdx].oStCell;
+
+	return enemyIdx;
+}
@@ -0,0 +1,62 @@
+#ifndef THREAT_H
+#define THREAT_H
+
+#include <stdint.h>
+#include "map.h"
+#include "trace.h"
+#include "enemy.h"
+#include "cellhash.h"
+
+/* Object Definitions */
+typedef struct ThreatTile
+{
+	uint64_t aRowBits[MAP_TILE_SIZE];	/* bit j of word i is set if cell (i, j) is threatened */
+} ThreatTile;
+
+typedef struct EnemyFire
+{
+	long* alCells;			/* cells in the line of fire of the enemy */
+	int nCells;
+	int cellCapacity;
+	long blockCell;			/* cell the line of fire stops at, -1 if none */
+	GameObj oStCell;		/* start cell of the enemy bullet */
+	int isValid;
+} EnemyFire;
+
+typedef struct ThreatMask
+{
+	ThreatTile** apTiles;	/* union of the lines of fire (same tiling as the map), NULL if no threat */
+	int* aiUsedTiles;
+	int nUsedTiles;
+	int tileCapacity;
+	int tileCols;
+	int rows;
+	int cols;
+	CellHash* pSources;		/* cell -> first entry of the enemies firing on the cell */
+	CellHash* pBlockers;	/* cell -> first entry of the enemies stopped at the cell */
+	int* aiEntryEnemy;		/* chain entries: enemy index */
+	int* aiEntryNext;		/* chain entries: next entry, -1 at the end */
+	int entryCapacity;
+	int nEntries;
+	int freeEntry;			/* released entries, chained with aiEntryNext */
+	EnemyFire* aFires;		/* line of fire cache of each enemy */
+	int nEnemies;
+	int* aiDirty;			/* enemies to recompute on the next refresh */
+	int nDirty;
+	TraceMemo* pTraces;		/* mirror-aware line of fire, NULL for a straight line */
+} ThreatMask;
+
+/* Threat Mask Managment Methods */
+ThreatMask* createThreatMask(const MapInfo* pMapInfo, const EnemySet* pEnemies, int isMirrorFire);
+void destroyThreatMask(ThreatMask* pThreat);
+void invalidateThreatMask(ThreatMask* pThreat);
+void invalidateEnemyFire(ThreatMask* pThreat, int enemyIdx);
+void invalidateThreatAt(ThreatMask* pThreat, int row, int col);
+void refreshThreatMask(ThreatMask* pThreat, const MapInfo* pMapInfo,
+							const EnemySet* pEnemies, GameObj* pPlayer);
+
+/* Threat Mask Query Methods */
+int isThreatened(const ThreatMask* pThreat, int row, int col);
+int findThreatSource(const ThreatMask* pThreat, int row, int col, GameObj* pBulletStCell);
+
+#endif
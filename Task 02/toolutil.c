@@ -0,0 +1,61 @@
+/* PURPOSE: Shared helpers of the command-line tools: wall-clock timing and
+ * the worker threads.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+#define _DEFAULT_SOURCE
+
+/* Standard Include */
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+/* Local Includes */
+#include "toolutil.h"
+
+/**************************************************************************************************/
+/* Timing Methods														    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Milliseconds since the start time.
+ *
+ * @param pStart start time (CLOCK_MONOTONIC).
+ * @return double elapsed time in milliseconds.
+ */
+double elapsedMs(const struct timespec* pStart)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - pStart->tv_sec) * 1000.0 + (now.tv_nsec - pStart->tv_nsec) / 1000000.0;
+}
+
+/**************************************************************************************************/
+/* Worker Pool Methods													    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Run each worker of the array on its own thread and wait for all of
+ * them. The calling thread is the first worker.
+ *
+ * @param aWorkers array of worker objects.
+ * @param workerSize size of a worker object.
+ * @param nWorkers number of workers (1 or more).
+ * @param pRun worker thread entry, called with the worker object.
+ */
+void runWorkers(void* aWorkers, size_t workerSize, int nWorkers, ToolWorker pRun)
+{
+	pthread_t* aThreads = (pthread_t*) malloc(sizeof(pthread_t) * nWorkers);
+	char* pWorkers = (char*) aWorkers;
+	int i;
+
+	for (i = 1; i < nWorkers; i++)
+		pthread_create(&(aThreads[i]), NULL, pRun, pWorkers + workerSize * i);
+
+	(*pRun)(pWorkers);
+
+	for (i = 1; i < nWorkers; i++)
+		pthread_join(aThreads[i], NULL);
+
+	free(aThreads);
+}
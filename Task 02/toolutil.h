@@ -0,0 +1,16 @@
+#ifndef TOOLUTIL_H
+#define TOOLUTIL_H
+
+#include <stddef.h>
+#include <time.h>
+
+/* Worker thread entry: the argument is the worker object */
+typedef void* (*ToolWorker)(void* pArg);
+
+/* Timing Methods */
+double elapsedMs(const struct timespec* pStart);
+
+/* Worker Pool Methods */
+void runWorkers(void* aWorkers, size_t workerSize, int nWorkers, ToolWorker pRun);
+
+#endif
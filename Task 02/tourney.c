@@ -0,0 +1,462 @@
+/* PURPOSE: Tournament runner: plays every agent on every level headlessly on
+ * a pool of threads, with a decision time budget per match, and writes a CSV
+ * leaderboard. The time spent in the agents and in the core are measured
+ * apart.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+#define _DEFAULT_SOURCE
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Local Includes */
+#include "tankcore.h"
+#include "agent.h"
+#include "toolutil.h"
+#include "macros.h"
+
+/* Object Definitions */
+typedef struct TourneyMatch
+{
+	GameStatus gameStatus;
+	int isPlayed;			/* the level could be loaded */
+	int isTimeout;			/* stopped: the agent ran out of decision time */
+	int nTurns;
+	double agentMs;			/* init, act and finish */
+	double engineMs;		/* restart and steps of the core */
+} TourneyMatch;
+
+typedef struct Tourney
+{
+	char** azLevels;		/* level files (config files of the game) */
+	int* aiIsLoaded;		/* the level could be loaded */
+	int nLevels;
+	const Agent* apAgents[TOURNEY_MAX_AGENTS];
+	int nAgents;
+	TourneyMatch* aMatches;	/* level-major: match i is level i / nAgents, agent i % nAgents */
+	int maxTurns;
+	double budgetMs;		/* agent decision time per match */
+	uint64_t seed;
+	GameOptions options;
+	int nextMatch;			/* next match to play (atomic) */
+} Tourney;
+
+typedef struct TourneyWorker
+{
+	Tourney* pTourney;
+	TankCore* pCore;		/* owned by the worker, holds the level of its last match */
+	int levelIdx;			/* level loaded in the core, -1 if none */
+} TourneyWorker;
+
+typedef struct AgentScore
+{
+	const Agent* pAgent;
+	int nMatches;
+	int nWon;
+	int nLost;
+	int nUnfinished;		/* still going after the maximum number of turns */
+	int nTimeouts;
+	long wonTurns;			/* turns of the won matches */
+	long nTurns;
+	double agentMs;
+	double engineMs;
+} AgentScore;
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Order of the leaderboard: most wins, then fewest losses and
+ * timeouts, then fewest turns to win. Used in qsort().
+ *
+ * @param pA score pointer.
+ * @param pB score pointer.
+ * @return int comparison result.
+ */
+static int compareScores(const void* pA, const void* pB)
+{
+	const AgentScore* pScoreA = (const AgentScore*) pA;
+	const AgentScore* pScoreB = (const AgentScore*) pB;
+	int order = pScoreB->nWon - pScoreA->nWon;
+
+	if (order == 0)
+		order = (pScoreA->nLost + pScoreA->nTimeouts) - (pScoreB->nLost + pScoreB->nTimeouts);
+	if (order == 0)
+		order = (pScoreA->wonTurns > pScoreB->wonTurns) - (pScoreA->wonTurns < pScoreB->wonTurns);
+
+	return order;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Select the agents of a comma separated list of names.
+ *
+ * @param zNames agent names.
+ * @param pTourney export variable for the agents.
+ * @return int success status, FALSE if a name is unknown or the list too long.
+ */
+static int selectAgents(char* zNames, Tourney* pTourney)
+{
+	char* zName = strtok(zNames, ",");
+	int isValid = TRUE;
+
+	pTourney->nAgents = 0;
+
+	while (isValid && zName)
+	{
+		isValid = (pTourney->nAgents < TOURNEY_MAX_AGENTS && findAgent(zName) != NULL);
+		if (isValid)
+			pTourney->apAgents[pTourney->nAgents++] = findAgent(zName);
+
+		zName = strtok(NULL, ",");
+	}
+
+	return isValid && pTourney->nAgents > 0;
+}
+
+/**************************************************************************************************/
+/* Match Methods														    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Play one match: the agent acts on the observation of each turn
+ * until the game is over, runs out of turns or the agent runs out of time.
+ *
+ * @param pWorker worker object.
+ * @param matchIdx index of the match.
+ */
+static void playMatch(TourneyWorker* pWorker, int matchIdx)
+{
+	Tourney* pTourney = pWorker->pTourney;
+	TourneyMatch* pMatch = &(pTourney->aMatches[matchIdx]);
+	const Agent* pAgent = pTourney->apAgents[matchIdx % pTourney->nAgents];
+	int levelIdx = matchIdx / pTourney->nAgents;
+	TankObservation observation;
+	struct timespec start;
+	void* pState;
+	char action;
+
+	/* PERF: The matches come in level order, a worker reloads a level once per run of matches */
+	if (pWorker->levelIdx != levelIdx)
+	{
+		resetTankCore(pWorker->pCore, pTourney->azLevels[levelIdx], &(pTourney->options));
+		pWorker->levelIdx = levelIdx;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	restartTankCore(pWorker->pCore);
+	observeTankCore(pWorker->pCore, &observation);
+	pMatch->engineMs += elapsedMs(&start);
+
+	/* Each match has its own seed, the agents play the same whatever the thread */
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	pState = pAgent->init(&observation, pTourney->seed + (uint64_t) matchIdx);
+	pMatch->agentMs += elapsedMs(&start);
+
+	pMatch->gameStatus = PROGRESSING;
+	pMatch->isTimeout = (pMatch->agentMs > pTourney->budgetMs);
+
+	while (pMatch->gameStatus == PROGRESSING && !pMatch->isTimeout &&
+				pMatch->nTurns < pTourney->maxTurns)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		action = pAgent->act(pState, &observation);
+		pMatch->agentMs += elapsedMs(&start);
+		pMatch->isTimeout = (pMatch->agentMs > pTourney->budgetMs);
+
+		if (!pMatch->isTimeout)
+		{
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			pMatch->gameStatus = stepTankCore(pWorker->pCore, action, &observation);
+			pMatch->engineMs += elapsedMs(&start);
+			pMatch->nTurns++;
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	pAgent->finish(pState, pMatch->gameStatus);
+	pMatch->agentMs += elapsedMs(&start);
+	pMatch->isPlayed = TRUE;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Thread body: play matches until none is left.
+ *
+ * @param pArg worker object.
+ * @return void* NULL.
+ */
+static void* runWorker(void* pArg)
+{
+	TourneyWorker* pWorker = (TourneyWorker*) pArg;
+	Tourney* pTourney = pWorker->pTourney;
+	int nMatches = pTourney->nLevels * pTourney->nAgents;
+	int matchIdx = __atomic_fetch_add(&(pTourney->nextMatch), 1, __ATOMIC_RELAXED);
+
+	while (matchIdx < nMatches)
+	{
+		if (pTourney->aiIsLoaded[matchIdx / pTourney->nAgents])
+			playMatch(pWorker, matchIdx);
+
+		matchIdx = __atomic_fetch_add(&(pTourney->nextMatch), 1, __ATOMIC_RELAXED);
+	}
+
+	return NULL;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Play all the matches.
+ *
+ * @param pTourney tournament object.
+ * @param nWorkers number of threads.
+ */
+static void playMatches(Tourney* pTourney, int nWorkers)
+{
+	TourneyWorker* aWorkers = (TourneyWorker*) calloc(nWorkers, sizeof(TourneyWorker));
+	int i;
+
+	for (i = 0; i < nWorkers; i++)
+	{
+		aWorkers[i].pTourney = pTourney;
+		aWorkers[i].pCore = createTankCore();
+		aWorkers[i].levelIdx = -1;
+	}
+
+	runWorkers(aWorkers, sizeof(TourneyWorker), nWorkers, &runWorker);
+
+	for (i = 0; i < nWorkers; i++)
+		destroyTankCore(aWorkers[i].pCore);
+
+	free(aWorkers);
+}
+
+/**************************************************************************************************/
+/* Leaderboard Methods													    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Sum up the matches of each agent, best agent first.
+ *
+ * @param pTourney tournament object, with the matches played.
+ * @param aScores export variable for the scores (one per agent).
+ */
+static void scoreAgents(const Tourney* pTourney, AgentScore* aScores)
+{
+	int i;
+
+	memset(aScores, 0, sizeof(AgentScore) * pTourney->nAgents);
+	for (i = 0; i < pTourney->nAgents; i++)
+		aScores[i].pAgent = pTourney->apAgents[i];
+
+	for (i = 0; i < pTourney->nLevels * pTourney->nAgents; i++)
+	{
+		const TourneyMatch* pMatch = &(pTourney->aMatches[i]);
+		AgentScore* pScore = &(aScores[i % pTourney->nAgents]);
+
+		if (pMatch->isPlayed)
+		{
+			pScore->nMatches++;
+			pScore->nTurns += pMatch->nTurns;
+			pScore->agentMs += pMatch->agentMs;
+			pScore->engineMs += pMatch->engineMs;
+
+			if (pMatch->gameStatus == ENEMY_HIT)
+			{
+				pScore->nWon++;
+				pScore->wonTurns += pMatch->nTurns;
+			}
+			else if (pMatch->gameStatus == PLAYER_HIT)
+				pScore->nLost++;
+			else if (pMatch->isTimeout)
+				pScore->nTimeouts++;
+			else
+				pScore->nUnfinished++;
+		}
+	}
+
+	qsort(aScores, pTourney->nAgents, sizeof(AgentScore), &compareScores);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Write the leaderboard (CSV, one line per agent, best agent first).
+ * A file that cannot be opened is reported on stderr.
+ *
+ * @param zFileName leaderboard file name.
+ * @param aScores scores, best agent first.
+ * @param nAgents number of agents.
+ * @return int success status.
+ */
+static int writeLeaderboard(const char* zFileName, const AgentScore* aScores, int nAgents)
+{
+	FILE* pFile = fopen(zFileName, "w");
+	int i;
+
+	if (pFile)
+	{
+		fprintf(pFile, "rank,agent,matches,won,lost,unfinished,timeouts,win_rate,"
+						"mean_turns_to_win,agent_ms,engine_ms,agent_us_per_turn,engine_us_per_turn\n");
+
+		for (i = 0; i < nAgents; i++)
+		{
+			const AgentScore* pScore = &(aScores[i]);
+			long nTurns = (pScore->nTurns > 0) ? pScore->nTurns : 1;
+
+			fprintf(pFile, "%d,%s,%d,%d,%d,%d,%d,%.4f,%.1f,%.3f,%.3f,%.3f,%.3f\n", i + 1,
+						pScore->pAgent->zName, pScore->nMatches, pScore->nWon, pScore->nLost,
+						pScore->nUnfinished, pScore->nTimeouts,
+						(pScore->nMatches > 0) ? (double) pScore->nWon / pScore->nMatches : 0.0,
+						(pScore->nWon > 0) ? (double) pScore->wonTurns / pScore->nWon : 0.0,
+						pScore->agentMs, pScore->engineMs, 1000.0 * pScore->agentMs / nTurns,
+						1000.0 * pScore->engineMs / nTurns);
+		}
+
+		fclose(pFile);
+	}
+	else
+	{
+		perror(zFileName);
+	}
+
+	return pFile != NULL;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Print the leaderboard.
+ *
+ * @param aScores scores, best agent first.
+ * @param nAgents number of agents.
+ */
+static void printLeaderboard(const AgentScore* aScores, int nAgents)
+{
+	int i;
+
+	printf("%-4s %-12s %7s %6s %6s %6s %6s %12s %12s %12s\n", "rank", "agent", "matches", "won",
+				"lost", "unfin", "t/out", "turns/win", "agent us/t", "engine us/t");
+
+	for (i = 0; i < nAgents; i++)
+	{
+		const AgentScore* pScore = &(aScores[i]);
+		long nTurns = (pScore->nTurns > 0) ? pScore->nTurns : 1;
+
+		printf("%-4d %-12s %7d %6d %6d %6d %6d %12.1f %12.3f %12.3f\n", i + 1,
+					pScore->pAgent->zName, pScore->nMatches, pScore->nWon, pScore->nLost,
+					pScore->nUnfinished, pScore->nTimeouts,
+					(pScore->nWon > 0) ? (double) pScore->wonTurns / pScore->nWon : 0.0,
+					1000.0 * pScore->agentMs / nTurns, 1000.0 * pScore->engineMs / nTurns);
+	}
+}
+
+/**************************************************************************************************/
+/* Main Entry															    		      		  */
+/**************************************************************************************************/
+int main(int argc, char *argv[])
+{
+	Tourney tourney;
+	AgentScore* aScores;
+	TankCore* pCore;
+	struct timespec start;
+	char* zAgentNames = NULL;
+	int i, nLoaded = 0, isValid = (argc >= 3), nWorkers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	int exitCode = EXIT_INIT_ERROR;
+
+	memset(&tourney, 0, sizeof(Tourney));
+	tourney.azLevels = (char**) malloc(sizeof(char*) * argc);
+	tourney.maxTurns = TOURNEY_DEFAULT_MAX_TURNS;
+	tourney.budgetMs = TOURNEY_DEFAULT_BUDGET_MS;
+	tourney.seed = 1;
+
+	/* Level files after the leaderboard file, with the optional flags in between */
+	for (i = 2; isValid && i < argc; i++)
+	{
+		if (strcmp(argv[i], "-a") == 0 && i + 1 < argc)
+			zAgentNames = argv[++i];
+		else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+			tourney.budgetMs = atof(argv[++i]);
+		else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+			tourney.maxTurns = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-m") == 0)
+			tourney.options.isMirrorFire = TRUE;
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+			tourney.seed = strtoul(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+			nWorkers = atoi(argv[++i]);
+		else if (argv[i][0] == '-')
+			isValid = FALSE;
+		else
+			tourney.azLevels[tourney.nLevels++] = argv[i];
+	}
+
+	if (zAgentNames)
+		isValid = isValid && selectAgents(zAgentNames, &tourney);
+	else
+	{
+		for (i = 0; i < countAgents() && i < TOURNEY_MAX_AGENTS; i++)
+			tourney.apAgents[tourney.nAgents++] = getAgent(i);
+	}
+
+	isValid = isValid && tourney.nLevels > 0 && tourney.maxTurns > 0 && tourney.budgetMs > 0 &&
+				nWorkers >= 1;
+
+	if (!isValid)
+	{
+		printf("Usage: %s <leaderboard file> <level file>... [-a agents] [-b budget] [-l max turns]\n"
+				"          [-m] [-s seed] [-t threads]\n", argv[0]);
+		printf("  leaderboard: CSV, one line per agent, best agent first\n");
+		printf("  -a  comma separated agents (default: all):");
+		for (i = 0; i < countAgents(); i++)
+			printf(" %s", getAgent(i)->zName);
+		printf("\n");
+		printf("  -b  agent decision time per match in ms, over it the match is stopped "
+					"(default: %.0f)\n", TOURNEY_DEFAULT_BUDGET_MS);
+		printf("  -l  turns before a match counts as unfinished (default: %d)\n",
+					TOURNEY_DEFAULT_MAX_TURNS);
+		printf("  -m  enemies bank shots off the mirrors\n");
+		printf("  -s  seed of the agents (default: 1)\n");
+		printf("  -t  number of worker threads (default: one per core)\n");
+	}
+	else
+	{
+		/* Each level is checked once here, so an invalid level is reported once */
+		tourney.aiIsLoaded = (int*) malloc(sizeof(int) * tourney.nLevels);
+		pCore = createTankCore();
+		for (i = 0; i < tourney.nLevels; i++)
+		{
+			tourney.aiIsLoaded[i] = resetTankCore(pCore, tourney.azLevels[i], &(tourney.options));
+			nLoaded += tourney.aiIsLoaded[i];
+		}
+		destroyTankCore(pCore);
+
+		tourney.aMatches = (TourneyMatch*) calloc(tourney.nLevels * tourney.nAgents,
+														sizeof(TourneyMatch));
+		aScores = (AgentScore*) malloc(sizeof(AgentScore) * tourney.nAgents);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		playMatches(&tourney, nWorkers);
+
+		scoreAgents(&tourney, aScores);
+		printLeaderboard(aScores, tourney.nAgents);
+		printf("%d matches (%d levels, %d invalid) on %d threads in %.1f ms\n",
+					nLoaded * tourney.nAgents, tourney.nLevels, tourney.nLevels - nLoaded,
+					nWorkers, elapsedMs(&start));
+
+		if (!writeLeaderboard(argv[1], aScores, tourney.nAgents))
+			exitCode = EXIT_SAVE_ERROR;
+		else
+			exitCode = (nLoaded == tourney.nLevels) ? EXIT_SUCCESS : EXIT_INIT_ERROR;
+
+		free(aScores);
+		free(tourney.aMatches);
+		free(tourney.aiIsLoaded);
+	}
+
+	free(tourney.azLevels);
+
+	return exitCode;
+}
@@ -0,0 +1,290 @@
+/* PURPOSE: Mirror-aware bullet traces of the Tank Game. Each straight leg of
+ * a trace is memoised per (start cell, direction) until the board changes.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Local Includes */
+#include "trace.h"
+#include "macros.h"
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Index (0 - 3) of a direction, used in the memo key.
+ *
+ * @param direction direction of the bullet.
+ * @return int index of the direction.
+ */
+static int directionIndex(char direction)
+{
+	return (direction == DIR_DOWN) + 2 * (direction == DIR_LEFT) + 3 * (direction == DIR_RIGHT);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Move the cell one step towards the direction.
+ *
+ * @param pCell cell to move.
+ * @param direction direction to move.
+ */
+static void stepCell(GameObj* pCell, char direction)
+{
+	pCell->row += (direction == DIR_DOWN) - (direction == DIR_UP);
+	pCell->col += (direction == DIR_RIGHT) - (direction == DIR_LEFT);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief A leg to fill: a released one, else a new one.
+ *
+ * @param pMemo trace memo object.
+ * @return int index of the leg.
+ */
+static int allocStep(TraceMemo* pMemo)
+{
+	int stepIdx = pMemo->freeStep;
+
+	if (stepIdx != -1)
+	{
+		pMemo->freeStep = pMemo->aSteps[stepIdx].next;
+	}
+	else
+	{
+		if (pMemo->nSteps == pMemo->stepCapacity)
+		{
+			pMemo->stepCapacity *= 2;
+			pMemo->aSteps = (TraceStep*) realloc(pMemo->aSteps,
+											sizeof(TraceStep) * pMemo->stepCapacity);
+		}
+
+		stepIdx = pMemo->nSteps++;
+	}
+
+	return stepIdx;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief The straight leg of a trace from (row, col) inclusive towards the
+ * direction: the first obstacle, looking through the transparent object.
+ * Memoised, the transparent object is not on the board the memo describes.
+ *
+ * @param pMemo trace memo object.
+ * @param pMapInfo map object.
+ * @param pStCell start cell and direction of the leg.
+ * @param pTransparent object the bullet passes through (can be NULL).
+ * @return const TraceStep* the memoised leg.
+ */
+static const TraceStep* traceStep(TraceMemo* pMemo, const MapInfo* pMapInfo,
+									const GameObj* pStCell, const GameObj* pTransparent)
+{
+	int isVertical = (pStCell->direction == DIR_UP || pStCell->direction == DIR_DOWN);
+	long key = ((long) pStCell->row * pMemo->cols + pStCell->col) * 4 +
+												directionIndex(pStCell->direction);
+	int stepIdx = lookupCellHash(pMemo->pLegs, key, -1);
+	long endKey;
+
+	if (stepIdx == -1)
+	{
+		GameObj cell = *pStCell;
+		int obstacle = findObstacle(pMapInfo, cell.row, cell.col, cell.direction);
+
+		/* Look through the transparent object (the player) */
+		while (pTransparent && pTransparent->row == (isVertical ? obstacle : cell.row) &&
+								pTransparent->col == (isVertical ? cell.col : obstacle))
+		{
+			cell.row = pTransparent->row;
+			cell.col = pTransparent->col;
+			stepCell(&cell, cell.direction);
+			obstacle = findObstacle(pMapInfo, cell.row, cell.col, cell.direction);
+		}
+
+		if (isVertical)
+			cell.row = obstacle;
+		else
+			cell.col = obstacle;
+
+		stepIdx = allocStep(pMemo);
+		pMemo->aSteps[stepIdx].key = key;
+		pMemo->aSteps[stepIdx].obstacle = obstacle;
+		pMemo->aSteps[stepIdx].obstacleCell = getCell(pMapInfo, cell.row, cell.col);
+		insertCellHash(pMemo->pLegs, key, stepIdx);
+
+		/* Chained on the obstacle cell, the leg is stale once the cell changes */
+		endKey = (long) cell.row * pMemo->cols + cell.col;
+		pMemo->aSteps[stepIdx].next = lookupCellHash(pMemo->pEnds, endKey, -1);
+		insertCellHash(pMemo->pEnds, endKey, stepIdx);
+	}
+
+	return &(pMemo->aSteps[stepIdx]);
+}
+
+/**************************************************************************************************/
+/* Trace Memo Managment Methods										    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Create an empty trace memo object for the map.
+ *
+ * @param pMapInfo map object.
+ * @return TraceMemo* trace memo object.
+ */
+TraceMemo* createTraceMemo(const MapInfo* pMapInfo)
+{
+	TraceMemo* pMemo = (TraceMemo*) malloc(sizeof(TraceMemo));
+
+	pMemo->rows = pMapInfo->rows;
+	pMemo->cols = pMapInfo->cols;
+	pMemo->pLegs = createCellHash(CELL_HASH_INIT_CAPACITY);
+	pMemo->pEnds = createCellHash(CELL_HASH_INIT_CAPACITY);
+	pMemo->stepCapacity = TRACE_INIT_MEMO_CAPACITY;
+	pMemo->aSteps = (TraceStep*) malloc(sizeof(TraceStep) * pMemo->stepCapacity);
+	pMemo->nSteps = 0;
+	pMemo->freeStep = -1;
+
+	return pMemo;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy the trace memo object. Call free().
+ *
+ * @param pMemo trace memo object.
+ */
+void destroyTraceMemo(TraceMemo* pMemo)
+{
+	destroyCellHash(pMemo->pLegs);
+	destroyCellHash(pMemo->pEnds);
+	free(pMemo->aSteps);
+	free(pMemo);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Forget the memoised legs. Call when the board (mirrors, tanks other
+ * than the transparent one) changes.
+ *
+ * @param pMemo trace memo object.
+ */
+void invalidateTraceMemo(TraceMemo* pMemo)
+{
+	clearCellHash(pMemo->pLegs);
+	clearCellHash(pMemo->pEnds);
+	pMemo->nSteps = 0;
+	pMemo->freeStep = -1;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Forget the memoised legs stopped at the cell. Call when the cell
+ * changes (e.g. the tank on it is destroyed). No leg runs through an obstacle,
+ * so the other legs still hold.
+ *
+ * @param pMemo trace memo object.
+ * @param row row index of the cell.
+ * @param col column index of the cell.
+ */
+void invalidateTraceAt(TraceMemo* pMemo, int row, int col)
+{
+	long endKey = (long) row * pMemo->cols + col;
+	int stepIdx = lookupCellHash(pMemo->pEnds, endKey, -1);
+	int next;
+
+	if (stepIdx != -1)
+		insertCellHash(pMemo->pEnds, endKey, -1);
+
+	while (stepIdx != -1)
+	{
+		next = pMemo->aSteps[stepIdx].next;
+		insertCellHash(pMemo->pLegs, pMemo->aSteps[stepIdx].key, -1);
+		pMemo->aSteps[stepIdx].next = pMemo->freeStep;
+		pMemo->freeStep = stepIdx;
+		stepIdx = next;
+	}
+}
+
+/**************************************************************************************************/
+/* Trace Methods														    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Direction of the bullet after hitting a mirror (same as the bullet
+ * animation).
+ *
+ * @param mirror mirror marker ('\' or '/').
+ * @param direction direction of the bullet.
+ * @return char new direction of the bullet.
+ */
+char reflectDirection(char mirror, char direction)
+{
+	char newDirection = direction;
+
+	switch (direction)
+	{
+		case DIR_UP:
+			newDirection = (mirror == MARKER_FACE_BMIRROR) ? DIR_LEFT : DIR_RIGHT;
+		break;
+
+		case DIR_DOWN:
+			newDirection = (mirror == MARKER_FACE_BMIRROR) ? DIR_RIGHT : DIR_LEFT;
+		break;
+
+		case DIR_LEFT:
+			newDirection = (mirror == MARKER_FACE_BMIRROR) ? DIR_UP : DIR_DOWN;
+		break;
+
+		case DIR_RIGHT:
+			newDirection = (mirror == MARKER_FACE_BMIRROR) ? DIR_DOWN : DIR_UP;
+		break;
+	}
+
+	return newDirection;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Follow a bullet from the start cell, reflecting on the mirrors, and
+ * visit each cell it passes through until it hits a tank or the border. The
+ * trace always ends: it starts next to a tank, so it cannot run in a cycle.
+ *
+ * @param pMemo trace memo object.
+ * @param pMapInfo map object.
+ * @param pStCell start cell and direction of the bullet.
+ * @param pTransparent object the bullet passes through (can be NULL).
+ * @param pVisit callback on each cell.
+ * @param pContext context passed to the callback.
+ * @param pHitCell export variable for the cell the bullet stops at.
+ */
+void traceLine(TraceMemo* pMemo, const MapInfo* pMapInfo, const GameObj* pStCell,
+					const GameObj* pTransparent, TraceVisit pVisit, void* pContext,
+					GameObj* pHitCell)
+{
+	GameObj cell = *pStCell;
+	int isReflected = TRUE;
+
+	while (isReflected)
+	{
+		const TraceStep* pStep = traceStep(pMemo, pMapInfo, &cell, pTransparent);
+		int isVertical = (cell.direction == DIR_UP || cell.direction == DIR_DOWN);
+
+		while ((isVertical ? cell.row : cell.col) != pStep->obstacle)
+		{
+			(*pVisit)(pContext, cell.row, cell.col);
+			stepCell(&cell, cell.direction);
+		}
+
+		*pHitCell = cell;
+		isReflected = (pStep->obstacleCell == MARKER_FACE_BMIRROR ||
+						pStep->obstacleCell == MARKER_FACE_FMIRROR);
+		if (isReflected)
+		{
+			cell.direction = reflectDirection(pStep->obstacleCell, cell.direction);
+			stepCell(&cell, cell.direction);
+		}
+	}
+}
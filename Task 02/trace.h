@@ -0,0 +1,43 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "map.h"
+#include "cellhash.h"
+
+/* Object Definitions */
+typedef struct TraceStep
+{
+	long key;			/* key of the leg in pLegs */
+	int obstacle;		/* row (up/down) or column (left/right) index of the obstacle */
+	char obstacleCell;	/* marker of the obstacle (mirror, tank or border) */
+	int next;			/* next leg stopped at the same cell (or next free leg), -1 at the end */
+} TraceStep;
+
+typedef struct TraceMemo
+{
+	CellHash* pLegs;	/* (row * cols + col) * 4 + direction index -> index of the leg */
+	CellHash* pEnds;	/* obstacle cell -> first leg stopped at the cell */
+	TraceStep* aSteps;	/* memoised legs */
+	int stepCapacity;
+	int nSteps;
+	int freeStep;		/* released legs, chained with next */
+	int rows;
+	int cols;
+} TraceMemo;
+
+/* Callback on each cell the bullet passes through */
+typedef void (*TraceVisit)(void* pContext, int row, int col);
+
+/* Trace Memo Managment Methods */
+TraceMemo* createTraceMemo(const MapInfo* pMapInfo);
+void destroyTraceMemo(TraceMemo* pMemo);
+void invalidateTraceMemo(TraceMemo* pMemo);
+void invalidateTraceAt(TraceMemo* pMemo, int row, int col);
+
+/* Trace Methods */
+char reflectDirection(char mirror, char direction);
+void traceLine(TraceMemo* pMemo, const MapInfo* pMapInfo, const GameObj* pStCell,
+					const GameObj* pTransparent, TraceVisit pVisit, void* pContext,
+					GameObj* pHitCell);
+
+#endif
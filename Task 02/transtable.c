@@ -0,0 +1,151 @@
+/* PURPOSE: Transposition table (state hash -> int) of the Tank Game. Fixed
+ * size: a few slots are probed per key and the home slot is overwritten once
+ * they are all taken, so the table never grows during a search.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdlib.h>
+#include <limits.h>
+
+/* Local Includes */
+#include "transtable.h"
+#include "macros.h"
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Slot of the key. Either the slot holding the key, a free slot or the
+ * home slot of the key to overwrite.
+ *
+ * @param pTable transposition table object.
+ * @param key state hash.
+ * @param pIsFound export variable, TRUE if the slot holds the key.
+ * @return int index of the slot.
+ */
+static int findSlot(const TransTable* pTable, uint64_t key, int* pIsFound)
+{
+	int mask = pTable->capacity - 1;
+	int home = (int) ((key ^ (key >> 32)) & (uint64_t) mask);
+	int i, slot, foundSlot = -1;
+
+	*pIsFound = FALSE;
+
+	for (i = 0; !(*pIsFound) && i < TRANS_TABLE_PROBES; i++)
+	{
+		slot = (home + i) & mask;
+
+		if (pTable->aiGenerations[slot] != pTable->generation)
+		{
+			if (foundSlot == -1)
+				foundSlot = slot;
+		}
+		else if (pTable->alKeys[slot] == key)
+		{
+			*pIsFound = TRUE;
+			foundSlot = slot;
+		}
+	}
+
+	return (foundSlot == -1) ? home : foundSlot;
+}
+
+/**************************************************************************************************/
+/* Transposition Table Managment Methods								    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Create an empty transposition table object.
+ *
+ * @param capacity number of slots (power of 2).
+ * @return TransTable* transposition table object.
+ */
+TransTable* createTransTable(int capacity)
+{
+	TransTable* pTable = (TransTable*) malloc(sizeof(TransTable));
+
+	pTable->capacity = capacity;
+	pTable->generation = 1;
+	pTable->alKeys = (uint64_t*) malloc(sizeof(uint64_t) * capacity);
+	pTable->aiValues = (int*) malloc(sizeof(int) * capacity);
+	pTable->aiGenerations = (int*) calloc(capacity, sizeof(int));
+
+	return pTable;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy the transposition table object. Call free().
+ *
+ * @param pTable transposition table object.
+ */
+void destroyTransTable(TransTable* pTable)
+{
+	free(pTable->alKeys);
+	free(pTable->aiValues);
+	free(pTable->aiGenerations);
+	free(pTable);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Remove all the keys, to reuse the table for another search.
+ * PERF: O(1), the slots of the previous generations read as free.
+ *
+ * @param pTable transposition table object.
+ */
+void clearTransTable(TransTable* pTable)
+{
+	int i;
+
+	pTable->generation++;
+
+	if (pTable->generation == INT_MAX)
+	{
+		for (i = 0; i < pTable->capacity; i++)
+			pTable->aiGenerations[i] = 0;
+
+		pTable->generation = 1;
+	}
+}
+
+/**************************************************************************************************/
+/* Transposition Table Access Methods									    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Value stored for the key.
+ *
+ * @param pTable transposition table object.
+ * @param key state hash.
+ * @param notFound value to return if the key is not in the table (never
+ * stored or overwritten since).
+ * @return int value of the key.
+ */
+int probeTransTable(const TransTable* pTable, uint64_t key, int notFound)
+{
+	int isFound;
+	int slot = findSlot(pTable, key, &isFound);
+
+	return isFound ? pTable->aiValues[slot] : notFound;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Store the value of the key, overwriting its previous value or the
+ * entry in its home slot if the probed slots are all taken.
+ *
+ * @param pTable transposition table object.
+ * @param key state hash.
+ * @param value value to store.
+ */
+void storeTransTable(TransTable* pTable, uint64_t key, int value)
+{
+	int isFound;
+	int slot = findSlot(pTable, key, &isFound);
+
+	pTable->alKeys[slot] = key;
+	pTable->aiValues[slot] = value;
+	pTable->aiGenerations[slot] = pTable->generation;
+}
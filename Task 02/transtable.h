@@ -0,0 +1,25 @@
+#ifndef TRANSTABLE_H
+#define TRANSTABLE_H
+
+#include <stdint.h>
+
+/* Object Definitions */
+typedef struct TransTable
+{
+	uint64_t* alKeys;		/* state hashes (ZobristHash) */
+	int* aiValues;
+	int* aiGenerations;		/* a slot of an older generation is free */
+	int capacity;			/* power of 2, fixed */
+	int generation;
+} TransTable;
+
+/* Transposition Table Managment Methods */
+TransTable* createTransTable(int capacity);
+void destroyTransTable(TransTable* pTable);
+void clearTransTable(TransTable* pTable);
+
+/* Transposition Table Access Methods */
+int probeTransTable(const TransTable* pTable, uint64_t key, int notFound);
+void storeTransTable(TransTable* pTable, uint64_t key, int value);
+
+#endif
@@ -11,6 +11,8 @@
 /* Local Includes */
 #include "util.h"
 #include "macros.h"
+#include "enemy.h"
+#include "bullet.h"
 
 /**************************************************************************************************/
 /* Refresh Params Related Methods												    		      */
@@ -20,27 +22,32 @@
  * 
  * @param pRP parameter object to pass across functions.
  * @param pMapInfo map object.
- * @param pEnemy enemy object.
+ * @param pEnemies enemy set object.
  * @param pPlayer player object.
- * @param pBullet bullet object.
+ * @param pBullets bullet pool object.
  * @param pMirrorList mirror linked list.
  * @param pLogList log linked list.
  * @param pLogFile log file - output file (FileEx).
  * @param isStoreMap whether to store the map as node in the log linked list.
  */
 void packRefreshParams(RefreshMapParam* pRP, MapInfo* pMapInfo, 
-				GameObj* pEnemy, GameObj* pPlayer, GameObj* pBullet,
+				struct EnemySet* pEnemies, GameObj* pPlayer, struct BulletPool* pBullets,
 				LinkedList* pMirrorList, LinkedList* pLogList, 
 				FileEx* pLogFile, int isStoreMap)
 {
 	pRP->pMapInfo = pMapInfo;
-	pRP->pEnemy = pEnemy;
+	pRP->pEnemies = pEnemies;
 	pRP->pPlayer = pPlayer;
-	pRP->pBullet = NULL;
+	pRP->pBullets = pBullets;
 	pRP->pMirrorList = pMirrorList;
 	pRP->pLogList = pLogList;
 	pRP->pLogFile = pLogFile;
 	pRP->isStoreMap = isStoreMap;
+	pRP->pThreat = NULL;
+	pRP->pZobrist = NULL;
+	pRP->pTerminal = NULL;
+	pRP->isHeadless = FALSE;
+	pRP->isLean = FALSE;
 }
 
 /**************************************************************************************************/
@@ -49,23 +56,23 @@ void packRefreshParams(RefreshMapParam* pRP, MapInfo* pMapInfo,
  * 
  * @param pRP parameter object to pass across functions.
  * @param ppMapInfo export variable for map object.
- * @param ppEnemy export variable for enemy object.
+ * @param ppEnemies export variable for enemy set object.
  * @param ppPlayer export variable for player object.
- * @param ppBullet export variable for bullet object.
+ * @param ppBullets export variable for bullet pool object.
  * @param ppMirrorList export variable for mirror linked list.
  * @param ppLogList export variable for log linked list.
  * @param ppLogFile export variable for log file.
  * @param piIsStoreMap export variable for store map boolean variable.
  */
 void unpackRefreshParams(RefreshMapParam* pRP, MapInfo** ppMapInfo, 
-				GameObj** ppEnemy, GameObj** ppPlayer, GameObj** ppBullet,
+				struct EnemySet** ppEnemies, GameObj** ppPlayer, struct BulletPool** ppBullets,
 				LinkedList** ppMirrorList, LinkedList** ppLogList, 
 				FileEx** ppLogFile, int* piIsStoreMap)
 {
 	*ppMapInfo = pRP->pMapInfo;
-	*ppEnemy = pRP->pEnemy;
+	*ppEnemies = pRP->pEnemies;
 	*ppPlayer = pRP->pPlayer;
-	*ppBullet = pRP->pBullet;
+	*ppBullets = pRP->pBullets;
 	*ppMirrorList = pRP->pMirrorList;
 	*ppLogList = pRP->pLogList;
 	*ppLogFile = pRP->pLogFile;
@@ -103,6 +110,20 @@ void copyObj(GameObj* pDestObj, GameObj* pSrcObj)
 		memcpy(pDestObj, pSrcObj, sizeof(GameObj));
 }
 
+/**************************************************************************************************/
+/**
+ * @brief Row and column step of a direction.
+ *
+ * @param direction direction to move.
+ * @param pdRow export variable for the row step.
+ * @param pdCol export variable for the column step.
+ */
+void directionStep(char direction, int* pdRow, int* pdCol)
+{
+	*pdRow = (direction == DIR_DOWN) - (direction == DIR_UP);
+	*pdCol = (direction == DIR_RIGHT) - (direction == DIR_LEFT);
+}
+
 /**************************************************************************************************/
 /* Debug Prints Related Methods														    	  	  */
 /**************************************************************************************************/
@@ -146,7 +167,8 @@ void debugObj(GameObj* pObj, const char* zPrefix)
 void debugMap(MapInfo* pMapInfo, const char* zPrefix)
 {
 #ifdef DEBUG
-	printf("%s: {%d, %d, %p}\n", zPrefix, pMapInfo->rows, pMapInfo->cols, (void*)pMapInfo->map);
+	printf("%s: {%d, %d, %p, %d}\n", zPrefix, pMapInfo->rows, pMapInfo->cols, 
+										(void*)pMapInfo->apTiles, pMapInfo->nUsedTiles);
 #endif
 }
 
@@ -161,34 +183,33 @@ void debugRefreshMapParams(RefreshMapParam* pRP, char* zPrefix)
 {
 #ifdef DEBUG
 
-	char zBullet[20];
-
 	MapInfo* pMapInfo;
-	GameObj *pPlayer, *pEnemy, *pBullet; 	
+	GameObj* pPlayer; 	
+	EnemySet* pEnemies;
+	BulletPool* pBullets;
 	LinkedList *pMirrorList, *pLogList;
 	FileEx* pLogFile; int isStoreMap;
 	unpackRefreshParams(pRP, &pMapInfo, 
-							&pEnemy, &pPlayer, &pBullet,
+							&pEnemies, &pPlayer, &pBullets,
 							&pMirrorList, &pLogList, 
 							&pLogFile, &isStoreMap);
-	toString(pBullet, zBullet);
 
 	/*
 	KEY:
 	M -> map
-	E -> enemy
+	E -> enemies (alive / total)
 	P -> player
-	B -> bullet	
+	B -> bullets in flight	
 	L -> linked lists
 	F -> file
 	SM -> store map
 	*/	
-	printf("%s: M:{%d, %d, %p} E:{%d, %d, %c} P:{%d, %d, %c} B:%s LL:{%p, %p} F:%p SM:%d\n", 
+	printf("%s: M:{%d, %d, %p} E:{%d / %d} P:{%d, %d, %c} B:%d LL:{%p, %p} F:%p SM:%d\n", 
 			zPrefix, 
-			pMapInfo->rows, pMapInfo->cols, (void*)pMapInfo->map,
-			pEnemy->row, pEnemy->col, pEnemy->direction,
+			pMapInfo->rows, pMapInfo->cols, (void*)pMapInfo->apTiles,
+			pEnemies->nAlive, pEnemies->nEnemies,
 			pPlayer->row, pPlayer->col, pPlayer->direction,
-			zBullet, (void*)pMirrorList, (void*)pLogList, (void*)pLogFile, isStoreMap);
+			(pBullets ? pBullets->nBullets : 0), (void*)pMirrorList, (void*)pLogList, (void*)pLogFile, isStoreMap);
 #endif
 }
 
@@ -218,50 +239,6 @@ void debugLinkedList(LinkedList* pList, char* prefix)
 	printInfo("-----------------------------------------------------------------------------------\n");
 }
 
-/**************************************************************************************************/
-/* Color Related Methods														    	  		  */
-/**************************************************************************************************/
-/**
- * @brief Put red color character on the terminal.
- * 
- * @param ch character to color.
- */
-void red(char ch) 
-{
-    printf("\033[1;31m");
-    printf("%c%s", ch, "\033[0m");
-
-	return;
-}
-
-/**************************************************************************************************/
-/**
- * @brief Put green color character on the terminal.
- * 
- * @param ch character to color.
- */
-void green(char ch)
-{
-    printf("\033[1;32m");
-    printf("%c%s", ch, "\033[0m");
-
-	return;
-}
-
-/**************************************************************************************************/
-/**
- * @brief Put red color string/error on the terminal.
- * 
- * @param zStr string to color.
- */
-void printError(char *zStr) 
-{
-    printf("\033[1;31m");
-    printf("[ERROR] %s%s", zStr, "\033[0m");
-
-	return;
-}
-
 /**************************************************************************************************/
 /* Debug Prints Methods														    	  		  	  */
 /**************************************************************************************************/
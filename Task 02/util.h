@@ -6,12 +6,12 @@
 
 /* RefreshParams related methods */
 void packRefreshParams(RefreshMapParam* pRP, MapInfo* pMapInfo, 
-				GameObj* pEnemy, GameObj* pPlayer, GameObj* pBullet,
+				struct EnemySet* pEnemies, GameObj* pPlayer, struct BulletPool* pBullets,
 				LinkedList* pMirrorList, LinkedList* pLogList, 
 				FileEx* pLogFile, int isStoreMap);
 
 void unpackRefreshParams(RefreshMapParam* pRP, MapInfo** ppMapInfo, 
-				GameObj** ppEnemy, GameObj** ppPlayer, GameObj** ppBullet,
+				struct EnemySet** ppEnemies, GameObj** ppPlayer, struct BulletPool** ppBullets,
 				LinkedList** ppMirrorList, LinkedList** ppLogList, 
 				FileEx** ppLogFile, int* piIsStoreMap);
 
@@ -19,6 +19,7 @@ void unpackRefreshParams(RefreshMapParam* pRP, MapInfo** ppMapInfo,
 /* Object (enemy, player, bullet, etc) related methods	*/
 void updateObj(GameObj* pObj, int row, int col, int dir);
 void copyObj(GameObj* pDestObj, GameObj* pSrcObj);
+void directionStep(char direction, int* pdRow, int* pdCol);
 
 /* Debug related methods */
 void toString(GameObj* pObj, char zObjStr[]);
@@ -27,12 +28,7 @@ void debugMap(MapInfo* pMapInfo, const char* zPrefix);
 void debugRefreshMapParams(RefreshMapParam* pRP, char* zPrefix);
 void debugLinkedList(LinkedList* pList, char* prefix);
 
-/* Color Related */
-void red(char ch);
-void green(char ch);
-
 /* Debug Prints */
-void printError(char *zStr);
 void printInfo(char *zStr);
 
 #endif
\ No newline at end of file
@@ -10,30 +10,43 @@
 /* Local Includes */
 #include "util.h"
 #include "macros.h"
+#include "bitboard.h"
+#include "enemy.h"
 
 /**************************************************************************************************/
 /* Helper Methods												    		      				  */
 /**************************************************************************************************/
-
+/**
+ * @brief Whether a cell between the enemy and the player is occupied. The
+ * range is empty (st > en) when the tanks are next to each other, the cell in
+ * front of the enemy is then in its line of fire (refer collectLineOfFire()).
+ * 
+ * @param pEnemy enemy object.
+ * @param pPlayer player object.
+ * @param pStCell start cell of the bullet (its direction gives the axis).
+ * @param pMapInfo map object.
+ * @param st first cell index between the tanks.
+ * @param en last cell index between the tanks.
+ * @return int TRUE if a cell of [st, en] is occupied.
+ */
 static int mirrorExistsBetween(GameObj* pEnemy, GameObj* pPlayer, GameObj* pStCell, 
 																MapInfo* pMapInfo, int st, int en)
 {	
 	int mirrorExists = FALSE;
-	int swapNeeded = (st > en);
-	int temp = st;
-	st = swapNeeded ? en : st;
-	en = swapNeeded ? temp : en;
+	int isVertical = (pStCell->direction == DIR_UP || pStCell->direction == DIR_DOWN);
 
-	while ((!mirrorExists) && (st <= en))
+	if (pMapInfo->pBitboard)
 	{
-		mirrorExists = (
-						((pStCell->direction == DIR_UP || pStCell->direction == DIR_DOWN) && 
-							pMapInfo->map[st][pStCell->col] != ' ') 
-						||
-						((pStCell->direction == DIR_RIGHT || pStCell->direction == DIR_LEFT) && 
-						pMapInfo->map[pStCell->row][st] != ' ')
-						);
-		st++;
+		/* PERF: Bitboard fast path, mask-and-test */
+		mirrorExists = isBitboardRangeOccupied(pMapInfo->pBitboard, 
+								isVertical ? pStCell->col : pStCell->row, st, en, isVertical);
+	}
+	else if (st <= en)
+	{
+		/* PERF: Scan the range with the SIMD kernels, refer findObstacle() */
+		mirrorExists = (findObstacle(pMapInfo, isVertical ? st : pStCell->row, 
+										isVertical ? pStCell->col : st, 
+										isVertical ? DIR_DOWN : DIR_RIGHT) <= en);
 	}
 
 	return mirrorExists;
@@ -163,19 +176,15 @@ int validateDirection(char direction)
  * 
  * @param pMapSize size of the map
  * @param pObj object to be validated.
- * @param zMsg message to display if invalid.
  * @return int validation status.
  */
-int validateObjBounds(MapInfo* pMapInfo, GameObj* pObject, char* zMsg)
+int validateObjBounds(MapInfo* pMapInfo, GameObj* pObject)
 {    
 	/* validity in the rows direction (y-direction) */
     int valid = BETWEEN(1, pMapInfo->rows-2, pObject->row);
 
 	/* validity in the cols direction (x-direction) */
     valid = valid && BETWEEN(1, pMapInfo->cols-2, pObject->col);
-
-    if (!valid && zMsg != NULL)
-        printError(zMsg);
     
     return valid;
 }
@@ -185,49 +194,66 @@ int validateObjBounds(MapInfo* pMapInfo, GameObj* pObject, char* zMsg)
  * @brief Validate the enemy and player tanks. Are they facing each other?, do 
  * they overlap each other?
  * 
- * @param pEnemy enemy object (int [3]).
+ * @param pEnemies enemy set object.
  * @param pPlayer player object (int [3]).
+ * @param piLoadError export variable for the error if invalid (LOAD_...).
  * @return int validation status.
  */
-int validateTanks(MapInfo* pMapInfo, GameObj* pEnemy, GameObj* pPlayer)
+int validateTanks(MapInfo* pMapInfo, EnemySet* pEnemies, GameObj* pPlayer, int* piLoadError)
 {
-	int isValid = TRUE;
+	int i, isValid = TRUE;
+	GameObj enemy;
 
 	/* checks if player is placed in front of enemy -> insant lose */
-	if (isObjOverlap(pEnemy, pPlayer))
+	if (findEnemyAt(pEnemies, pPlayer->row, pPlayer->col) != -1)
 	{
-		printError("Player and enemy cannot start on the same cell.\n");
+		*piLoadError = LOAD_TANK_OVERLAP;
 		isValid = FALSE;
 	}
-	else if (isFacingPlayer(pEnemy, pPlayer, NULL, pMapInfo))
+
+	for (i = 0; isValid && i < pEnemies->nEnemies; i++)
 	{
-		printError("Cannot place tanks in instant lose position.\n");
-		isValid = FALSE;
+		getEnemy(pEnemies, i, &enemy);
+		if (isFacingPlayer(&enemy, pPlayer, NULL, pMapInfo))
+		{
+			*piLoadError = LOAD_INSTANT_LOSE;
+			isValid = FALSE;
+		}
 	}
 
 	return isValid;
 }
 
-
+/**************************************************************************************************/
+/**
+ * @brief Validate a mirror: inside the bounds, not on a tank.
+ * 
+ * @param pMirror mirror object.
+ * @param pMapInfo map object.
+ * @param pEnemies enemy set object.
+ * @param pPlayer player object.
+ * @param piLoadError export variable for the error if invalid (LOAD_...).
+ * @return int validation status.
+ */
 int validateMirror(GameObj* pMirror, MapInfo* pMapInfo,
- 							GameObj* pEnemy, GameObj* pPlayer)
+ 							EnemySet* pEnemies, GameObj* pPlayer, int* piLoadError)
 {
 	int isValid = TRUE;
 	
 	if( !BETWEEN(0, pMapInfo->rows, pMirror->row) || 
 		!BETWEEN(0, pMapInfo->cols, pMirror->col) )
 	{
-		printError("Mirror must be placed inside bounds\n");
+		*piLoadError = LOAD_MIRROR_BOUNDS;
 		isValid = FALSE;
 	}	
 	else if (isObjOverlap(pMirror, pPlayer))
 	{
-		printError("Mirror must not overlap player\n");
+		*piLoadError = LOAD_MIRROR_ON_PLAYER;
 		isValid = FALSE;
 	}
-	else if (isObjOverlap(pMirror, pEnemy))
+	else if (findEnemyAt(pEnemies, pMirror->row, pMirror->col) != -1)
 	{
-		printError("Mirror must not overlap enemy\n");
+		*piLoadError = LOAD_MIRROR_ON_ENEMY;
 		isValid = FALSE;
 	}
 	
@@ -8,8 +8,9 @@ int isObjOverlap(GameObj* pObj1, GameObj* pObj2);
 
 /* Validation Methods */
 int validateDirection(char direction);
-int validateObjBounds(MapInfo* pMapInfo, GameObj* pObject, char* zMsg);
-int validateTanks(MapInfo* pMapInfo, GameObj* pEnemy, GameObj* pPlayer);
+int validateObjBounds(MapInfo* pMapInfo, GameObj* pObject);
+int validateTanks(MapInfo* pMapInfo, struct EnemySet* pEnemies, GameObj* pPlayer,
+																int* piLoadError);
 int validateMirror(GameObj* pMirror, MapInfo* pMapInfo,
- 							GameObj* pEnemy, GameObj* pPlayer);
+ 							struct EnemySet* pEnemies, GameObj* pPlayer, int* piLoadError);
 #endif
\ No newline at end of file
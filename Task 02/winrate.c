@@ -0,0 +1,457 @@
+/* PURPOSE: Win-rate estimator: plays many random (or cautious) games of each
+ * level headlessly and reports the win and loss rates, the turns to the
+ * outcome and their 95% confidence intervals. The rollouts run on a pool of
+ * threads, each thread with its own game core.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+#define _DEFAULT_SOURCE
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Local Includes */
+#include "tankcore.h"
+#include "threat.h"
+#include "transtable.h"
+#include "rng.h"
+#include "toolutil.h"
+#include "macros.h"
+
+/* Object Definitions */
+typedef struct RateStats
+{
+	long nWon;
+	long nLost;
+	long nUnfinished;		/* still going after the maximum number of turns */
+	uint64_t wonTurns;		/* sum of the turns of the won games */
+	uint64_t wonTurns2;		/* sum of the squares */
+	uint64_t lostTurns;
+	uint64_t lostTurns2;
+} RateStats;
+
+typedef struct RateConfig
+{
+	char** azLevels;		/* level files (config files of the game) */
+	int* aiIsLoaded;		/* the level could be loaded */
+	int nLevels;
+	long nRollouts;			/* games per level */
+	long nTasksPerLevel;	/* blocks of RATE_ROLLOUTS_PER_TASK games */
+	int maxTurns;
+	int policy;				/* RATE_POLICY_... */
+	uint64_t seed;
+	GameOptions options;
+	long nextTask;			/* next block of games to play (atomic) */
+} RateConfig;
+
+typedef struct RateWorker
+{
+	RateConfig* pConfig;
+	RateStats* aStats;		/* per level, merged once the threads are done */
+	TankCore* pCore;		/* owned by the worker, holds the level of its last block */
+	int levelIdx;			/* level loaded in the core, -1 if none */
+	TransTable* pSafeMoves;	/* state hash -> safe moves (bit i: acActions[i]), any level */
+} RateWorker;
+
+/* Moves in facing order, then the shot */
+static const char acFacings[4] = {DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT};
+static const char acActions[RATE_ACTIONS] = {KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT, KEY_SHOOT};
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Wilson score interval of a rate (95%), stays within [0, 1] even for
+ * rates close to 0 or 1.
+ *
+ * @param nHits games with the outcome.
+ * @param nGames games played.
+ * @param pLo export variable for the lower bound.
+ * @param pHi export variable for the upper bound.
+ */
+static void rateInterval(long nHits, long nGames, double* pLo, double* pHi)
+{
+	double z2 = RATE_Z_95 * RATE_Z_95;
+	double rate = (double) nHits / nGames;
+	double scale = 1.0 / (1.0 + z2 / nGames);
+	double centre = (rate + z2 / (2.0 * nGames)) * scale;
+	double half = RATE_Z_95 * sqrt(rate * (1.0 - rate) / nGames +
+								z2 / (4.0 * nGames * nGames)) * scale;
+
+	*pLo = (centre - half < 0.0) ? 0.0 : centre - half;
+	*pHi = (centre + half > 1.0) ? 1.0 : centre + half;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Print the mean turns of the games with an outcome and the half width
+ * of its 95% confidence interval, or "-" if no game had the outcome.
+ *
+ * @param nGames games with the outcome.
+ * @param sum sum of their turns.
+ * @param sum2 sum of the squares of their turns.
+ */
+static void printMeanTurns(long nGames, uint64_t sum, uint64_t sum2)
+{
+	double mean, variance;
+
+	if (nGames == 0)
+		printf("  %-15s", "-");
+	else
+	{
+		mean = (double) sum / nGames;
+		variance = (nGames > 1) ? ((double) sum2 - mean * sum) / (nGames - 1) : 0.0;
+		printf("  %7.1f +- %-5.1f", mean, RATE_Z_95 * sqrt(variance > 0.0 ? variance : 0.0) /
+																sqrt((double) nGames));
+	}
+}
+
+/**************************************************************************************************/
+/* Policy Methods														    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Moves of the player that are not into a line of fire.
+ *
+ * @param pCore tank core object, in an episode in progress.
+ * @return int safe moves, bit i is set if acActions[i] is safe.
+ */
+static int findSafeMoves(TankCore* pCore)
+{
+	RefreshMapParam* pRP = &(pCore->oRP);
+	int i, row, col, safeMask = 0;
+
+	/* The lines of fire are stale after a kill, the map holds the player */
+	refreshThreatMask(pRP->pThreat, pRP->pMapInfo, pRP->pEnemies, &(pCore->player));
+
+	for (i = 0; i < 4; i++)
+	{
+		row = pCore->player.row;
+		col = pCore->player.col;
+
+		if (pCore->player.direction == acFacings[i])
+		{
+			row += (acFacings[i] == DIR_DOWN) - (acFacings[i] == DIR_UP);
+			col += (acFacings[i] == DIR_RIGHT) - (acFacings[i] == DIR_LEFT);
+		}
+
+		if (!isThreatened(pRP->pThreat, row, col))
+			safeMask |= 1 << i;
+	}
+
+	return safeMask;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Cautious action: a turn, a shot or a move, uniformly, but never a
+ * move into a line of fire (the enemy would shoot).
+ * PERF: The games of a level go through the same states over and over, the
+ * safe moves of a state are looked up by its hash before they are computed.
+ *
+ * @param pWorker worker object, with the level loaded.
+ * @param pObservation observation of the turn.
+ * @param pRng random stream of the game.
+ * @return char move key or KEY_SHOOT.
+ */
+static char safeAction(RateWorker* pWorker, const TankObservation* pObservation, Rng* pRng)
+{
+	char acSafe[RATE_ACTIONS];
+	int i, nSafe = 0;
+	int safeMask = probeTransTable(pWorker->pSafeMoves, pObservation->stateHash, -1);
+
+	if (safeMask == -1)
+	{
+		safeMask = findSafeMoves(pWorker->pCore);
+		storeTransTable(pWorker->pSafeMoves, pObservation->stateHash, safeMask);
+	}
+
+	for (i = 0; i < 4; i++)
+	{
+		if ((safeMask >> i) & 1)
+			acSafe[nSafe++] = acActions[i];
+	}
+
+	acSafe[nSafe++] = KEY_SHOOT;
+
+	return acSafe[rangeRng(pRng, 0, nSafe - 1)];
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Play one game of the loaded level until it is over or runs out of
+ * turns, and count its outcome.
+ *
+ * @param pWorker worker object, with the level loaded.
+ * @param pRng random stream of the game.
+ * @param pStats statistics of the level.
+ */
+static void playRollout(RateWorker* pWorker, Rng* pRng, RateStats* pStats)
+{
+	const RateConfig* pConfig = pWorker->pConfig;
+	TankCore* pCore = pWorker->pCore;
+	GameStatus gameStatus = PROGRESSING;
+	TankObservation observation;
+	uint64_t nTurns = 0;
+	char action;
+
+	restartTankCore(pCore);
+	observeTankCore(pCore, &observation);
+
+	while (gameStatus == PROGRESSING && nTurns < (uint64_t) pConfig->maxTurns)
+	{
+		if (pConfig->policy == RATE_POLICY_SAFE)
+			action = safeAction(pWorker, &observation, pRng);
+		else
+			action = acActions[rangeRng(pRng, 0, RATE_ACTIONS - 1)];
+
+		gameStatus = stepTankCore(pCore, action, &observation);
+		nTurns++;
+	}
+
+	if (gameStatus == ENEMY_HIT)
+	{
+		pStats->nWon++;
+		pStats->wonTurns += nTurns;
+		pStats->wonTurns2 += nTurns * nTurns;
+	}
+	else if (gameStatus == PLAYER_HIT)
+	{
+		pStats->nLost++;
+		pStats->lostTurns += nTurns;
+		pStats->lostTurns2 += nTurns * nTurns;
+	}
+	else
+		pStats->nUnfinished++;
+}
+
+/**************************************************************************************************/
+/* Worker Methods														    	      		  */
+/**************************************************************************************************/
+/**
+ * @brief Thread body: play blocks of games until none is left. Game r of
+ * level l always draws from the stream (l, r), the estimates do not depend on
+ * the number of threads.
+ *
+ * @param pArg worker object.
+ * @return void* NULL.
+ */
+static void* runWorker(void* pArg)
+{
+	RateWorker* pWorker = (RateWorker*) pArg;
+	RateConfig* pConfig = pWorker->pConfig;
+	long nTasks = pConfig->nTasksPerLevel * pConfig->nLevels;
+	long rollout, lastRollout, task = __atomic_fetch_add(&(pConfig->nextTask), 1, __ATOMIC_RELAXED);
+	int levelIdx;
+	Rng rng;
+
+	while (task < nTasks)
+	{
+		levelIdx = (int) (task / pConfig->nTasksPerLevel);
+		rollout = (task % pConfig->nTasksPerLevel) * RATE_ROLLOUTS_PER_TASK;
+		lastRollout = rollout + RATE_ROLLOUTS_PER_TASK;
+		lastRollout = (lastRollout < pConfig->nRollouts) ? lastRollout : pConfig->nRollouts;
+
+		/* PERF: The blocks come in level order, a worker reloads a level once per run of blocks */
+		if (pConfig->aiIsLoaded[levelIdx] && pWorker->levelIdx != levelIdx)
+		{
+			resetTankCore(pWorker->pCore, pConfig->azLevels[levelIdx], &(pConfig->options));
+			pWorker->levelIdx = levelIdx;
+		}
+
+		for (; pConfig->aiIsLoaded[levelIdx] && rollout < lastRollout; rollout++)
+		{
+			seedRng(&rng, pConfig->seed, ((uint64_t) levelIdx << 32) | (uint64_t) rollout);
+			playRollout(pWorker, &rng, &(pWorker->aStats[levelIdx]));
+		}
+
+		task = __atomic_fetch_add(&(pConfig->nextTask), 1, __ATOMIC_RELAXED);
+	}
+
+	return NULL;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Play all the games of all the levels.
+ *
+ * @param pConfig estimator configuration.
+ * @param nWorkers number of threads.
+ * @param aTotals export variable for the statistics of each level.
+ */
+static void playLevels(RateConfig* pConfig, int nWorkers, RateStats* aTotals)
+{
+	RateWorker* aWorkers = (RateWorker*) calloc(nWorkers, sizeof(RateWorker));
+	int i, j;
+
+	for (i = 0; i < nWorkers; i++)
+	{
+		aWorkers[i].pConfig = pConfig;
+		aWorkers[i].aStats = (RateStats*) calloc(pConfig->nLevels, sizeof(RateStats));
+		aWorkers[i].pCore = createTankCore();
+		aWorkers[i].levelIdx = -1;
+		aWorkers[i].pSafeMoves = (pConfig->policy == RATE_POLICY_SAFE) ?
+										createTransTable(RATE_SAFE_TABLE_SIZE) : NULL;
+	}
+
+	runWorkers(aWorkers, sizeof(RateWorker), nWorkers, &runWorker);
+	memset(aTotals, 0, sizeof(RateStats) * pConfig->nLevels);
+
+	for (i = 0; i < nWorkers; i++)
+	{
+		for (j = 0; j < pConfig->nLevels; j++)
+		{
+			aTotals[j].nWon += aWorkers[i].aStats[j].nWon;
+			aTotals[j].nLost += aWorkers[i].aStats[j].nLost;
+			aTotals[j].nUnfinished += aWorkers[i].aStats[j].nUnfinished;
+			aTotals[j].wonTurns += aWorkers[i].aStats[j].wonTurns;
+			aTotals[j].wonTurns2 += aWorkers[i].aStats[j].wonTurns2;
+			aTotals[j].lostTurns += aWorkers[i].aStats[j].lostTurns;
+			aTotals[j].lostTurns2 += aWorkers[i].aStats[j].lostTurns2;
+		}
+
+		destroyTankCore(aWorkers[i].pCore);
+		if (aWorkers[i].pSafeMoves)
+			destroyTransTable(aWorkers[i].pSafeMoves);
+		free(aWorkers[i].aStats);
+	}
+
+	free(aWorkers);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Print the estimates of each level.
+ *
+ * @param pConfig estimator configuration.
+ * @param aTotals statistics of each level.
+ */
+static void printReport(const RateConfig* pConfig, const RateStats* aTotals)
+{
+	int i;
+	double lo, hi;
+
+	printf("%-24s %9s  %-22s %-22s %6s  %-15s  %-15s\n", "level", "games", "won % [95% CI]",
+				"lost % [95% CI]", "unfin%", "turns to win", "turns to loss");
+
+	for (i = 0; i < pConfig->nLevels; i++)
+	{
+		printf("%-24s", pConfig->azLevels[i]);
+
+		if (!pConfig->aiIsLoaded[i])
+			printf(" %9s\n", "invalid");
+		else
+		{
+			printf(" %9ld", pConfig->nRollouts);
+			rateInterval(aTotals[i].nWon, pConfig->nRollouts, &lo, &hi);
+			printf("  %6.2f [%6.2f, %6.2f]", 100.0 * aTotals[i].nWon / pConfig->nRollouts,
+						100.0 * lo, 100.0 * hi);
+			rateInterval(aTotals[i].nLost, pConfig->nRollouts, &lo, &hi);
+			printf(" %6.2f [%6.2f, %6.2f]", 100.0 * aTotals[i].nLost / pConfig->nRollouts,
+						100.0 * lo, 100.0 * hi);
+			printf(" %6.2f", 100.0 * aTotals[i].nUnfinished / pConfig->nRollouts);
+			printMeanTurns(aTotals[i].nWon, aTotals[i].wonTurns, aTotals[i].wonTurns2);
+			printMeanTurns(aTotals[i].nLost, aTotals[i].lostTurns, aTotals[i].lostTurns2);
+			printf("\n");
+		}
+	}
+}
+
+/**************************************************************************************************/
+/* Main Entry															    		      		  */
+/**************************************************************************************************/
+int main(int argc, char *argv[])
+{
+	RateConfig config;
+	RateStats* aTotals;
+	TankCore* pCore;
+	struct timespec start;
+	double timeMs;
+	int i, nLoaded = 0, isValid = TRUE, nWorkers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	int exitCode = EXIT_INIT_ERROR;
+
+	memset(&config, 0, sizeof(RateConfig));
+	config.azLevels = (char**) malloc(sizeof(char*) * argc);
+	config.nRollouts = RATE_DEFAULT_ROLLOUTS;
+	config.maxTurns = RATE_DEFAULT_MAX_TURNS;
+	config.policy = RATE_POLICY_RANDOM;
+	config.seed = 1;
+
+	/* Level files, with the optional flags in between */
+	for (i = 1; isValid && i < argc; i++)
+	{
+		if (strcmp(argv[i], "-m") == 0)
+			config.options.isMirrorFire = TRUE;
+		else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			config.nRollouts = atol(argv[++i]);
+		else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+			config.maxTurns = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+		{
+			i++;
+			config.policy = (strcmp(argv[i], "safe") == 0) ? RATE_POLICY_SAFE : RATE_POLICY_RANDOM;
+			isValid = (config.policy == RATE_POLICY_SAFE || strcmp(argv[i], "random") == 0);
+		}
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+			config.seed = strtoul(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+			nWorkers = atoi(argv[++i]);
+		else if (argv[i][0] == '-')
+			isValid = FALSE;
+		else
+			config.azLevels[config.nLevels++] = argv[i];
+	}
+
+	isValid = isValid && config.nLevels > 0 && config.nRollouts > 0 && config.maxTurns > 0 &&
+				nWorkers >= 1;
+
+	if (!isValid)
+	{
+		printf("Usage: %s <level file>... [-m] [-n games] [-l max turns] [-p random|safe]\n"
+				"          [-s seed] [-t threads]\n", argv[0]);
+		printf("  -m  enemies bank shots off the mirrors\n");
+		printf("  -n  games per level (default: %d)\n", RATE_DEFAULT_ROLLOUTS);
+		printf("  -l  turns before a game counts as unfinished (default: %d)\n",
+					RATE_DEFAULT_MAX_TURNS);
+		printf("  -p  random: any key, safe: never moves into a line of fire (default: random)\n");
+		printf("  -s  seed, the same seed gives the same estimates (default: 1)\n");
+		printf("  -t  number of worker threads (default: one per core)\n");
+	}
+	else
+	{
+		/* Each level is checked once here, so an invalid level is reported once */
+		config.aiIsLoaded = (int*) malloc(sizeof(int) * config.nLevels);
+		pCore = createTankCore();
+		for (i = 0; i < config.nLevels; i++)
+		{
+			config.aiIsLoaded[i] = resetTankCore(pCore, config.azLevels[i], &(config.options));
+			nLoaded += config.aiIsLoaded[i];
+		}
+		destroyTankCore(pCore);
+
+		config.nTasksPerLevel = (config.nRollouts + RATE_ROLLOUTS_PER_TASK - 1) /
+									RATE_ROLLOUTS_PER_TASK;
+		aTotals = (RateStats*) malloc(sizeof(RateStats) * config.nLevels);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		playLevels(&config, nWorkers, aTotals);
+		timeMs = elapsedMs(&start);
+
+		printReport(&config, aTotals);
+		printf("%ld games on %d threads, %.1f ms, %.0f games/s\n", config.nRollouts * nLoaded,
+					nWorkers, timeMs, config.nRollouts * nLoaded * 1000.0 / (timeMs > 0 ? timeMs : 1));
+
+		exitCode = (nLoaded == config.nLevels) ? EXIT_SUCCESS : EXIT_INIT_ERROR;
+		free(aTotals);
+		free(config.aiIsLoaded);
+	}
+
+	free(config.azLevels);
+
+	return exitCode;
+}
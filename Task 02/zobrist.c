@@ -0,0 +1,158 @@
+/* PURPOSE: Zobrist hash of the game state (player cell and facing, enemies
+ * alive) on top of the level identity. A move or a kill updates the hash in
+ * O(1), solvers and analyzers key their transposition tables with it.
+ * AUTHOR: Nadith Pathirage <<StudentID>>
+ * DATE CREATED: 19/10/2026
+ * DATE MODIFIED: 19/10/2026
+ */
+
+/* Standard Include */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Local Includes */
+#include "zobrist.h"
+#include "rng.h"
+#include "macros.h"
+
+/**************************************************************************************************/
+/* Helper Methods												    		      				  */
+/**************************************************************************************************/
+/**
+ * @brief Random looking key of a game element.
+ * PERF: Computed on the fly, no key table sized by the map.
+ *
+ * @param kind kind of element (ZOBRIST_...).
+ * @param value element value, unique within the kind.
+ * @return uint64_t key.
+ */
+static uint64_t mixKey(int kind, uint64_t value)
+{
+	return mixBits((value * ZOBRIST_KINDS + kind + 1) * SPLITMIX_GOLDEN);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Key of a game object at its cell, with its facing.
+ *
+ * @param pZobrist zobrist hash object.
+ * @param kind kind of element (ZOBRIST_...).
+ * @param pObj game object.
+ * @return uint64_t key.
+ */
+static uint64_t objKey(const ZobristHash* pZobrist, int kind, const GameObj* pObj)
+{
+	uint64_t cellKey = (uint64_t) pObj->row * pZobrist->cols + pObj->col;
+
+	return mixKey(kind, (cellKey << 8) | (unsigned char) pObj->direction);
+}
+
+/**************************************************************************************************/
+/* Zobrist Hash Managment Methods										    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief Create a zobrist hash object for a level. Call resetZobristHash()
+ * before the first update.
+ *
+ * @param pMapInfo map object.
+ * @param pEnemies enemy set object, with every enemy of the level.
+ * @param pMirrorList mirror linked list.
+ * @param isMirrorFire enemies bank shots off the mirrors.
+ * @return ZobristHash* zobrist hash object.
+ */
+ZobristHash* createZobristHash(const MapInfo* pMapInfo, const EnemySet* pEnemies,
+								LinkedList* pMirrorList, int isMirrorFire)
+{
+	ZobristHash* pZobrist = (ZobristHash*) malloc(sizeof(ZobristHash));
+	LinkedListNode* pCur = pMirrorList ? pMirrorList->pHead : NULL;
+	int i;
+	GameObj enemy;
+
+	pZobrist->cols = pMapInfo->cols;
+	pZobrist->boardKey = mixKey(ZOBRIST_BOARD, ((uint64_t) pMapInfo->rows << 32 |
+									(uint64_t) pMapInfo->cols << 1) | (isMirrorFire != 0));
+
+	while (pCur != NULL)
+	{
+		pZobrist->boardKey ^= objKey(pZobrist, ZOBRIST_MIRROR, (GameObj*) pCur->pData);
+		pCur = pCur->pNext;
+	}
+
+	for (i = 0; i < pEnemies->nEnemies; i++)
+	{
+		getEnemy(pEnemies, i, &enemy);
+		pZobrist->boardKey ^= objKey(pZobrist, ZOBRIST_LEVEL_ENEMY, &enemy);
+	}
+
+	pZobrist->hash = pZobrist->boardKey;
+
+	return pZobrist;
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Destroy the zobrist hash object. Call free().
+ *
+ * @param pZobrist zobrist hash object.
+ */
+void destroyZobristHash(ZobristHash* pZobrist)
+{
+	free(pZobrist);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief Hash the state from scratch (start of an episode).
+ *
+ * @param pZobrist zobrist hash object.
+ * @param pEnemies enemy set object.
+ * @param pPlayer player object.
+ */
+void resetZobristHash(ZobristHash* pZobrist, const EnemySet* pEnemies, const GameObj* pPlayer)
+{
+	int i;
+	GameObj enemy;
+
+	pZobrist->hash = pZobrist->boardKey ^ objKey(pZobrist, ZOBRIST_PLAYER, pPlayer);
+
+	for (i = 0; i < pEnemies->nEnemies; i++)
+	{
+		if (pEnemies->aIsAlive[i])
+		{
+			getEnemy(pEnemies, i, &enemy);
+			pZobrist->hash ^= objKey(pZobrist, ZOBRIST_ENEMY, &enemy);
+		}
+	}
+}
+
+/**************************************************************************************************/
+/* Zobrist Hash Update Methods											    		      		  */
+/**************************************************************************************************/
+/**
+ * @brief The player turned or moved.
+ *
+ * @param pZobrist zobrist hash object.
+ * @param pOld player before the key.
+ * @param pNew player after the key.
+ */
+void moveZobristPlayer(ZobristHash* pZobrist, const GameObj* pOld, const GameObj* pNew)
+{
+	pZobrist->hash ^= objKey(pZobrist, ZOBRIST_PLAYER, pOld) ^
+						objKey(pZobrist, ZOBRIST_PLAYER, pNew);
+}
+
+/**************************************************************************************************/
+/**
+ * @brief An enemy was destroyed (call once per enemy).
+ *
+ * @param pZobrist zobrist hash object.
+ * @param pEnemies enemy set object.
+ * @param enemyIdx index of the destroyed enemy.
+ */
+void killZobristEnemy(ZobristHash* pZobrist, const EnemySet* pEnemies, int enemyIdx)
+{
+	GameObj enemy;
+
+	getEnemy(pEnemies, enemyIdx, &enemy);
+	pZobrist->hash ^= objKey(pZobrist, ZOBRIST_ENEMY, &enemy);
+}
@@ -0,0 +1,26 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <stdint.h>
+#include "map.h"
+#include "enemy.h"
+
+/* Object Definitions */
+typedef struct ZobristHash
+{
+	uint64_t boardKey;		/* level identity: size, mirrors, enemy cells and fire mode */
+	uint64_t hash;			/* board key ^ player key ^ keys of the enemies alive */
+	int cols;				/* map columns, for the cell keys */
+} ZobristHash;
+
+/* Zobrist Hash Managment Methods */
+ZobristHash* createZobristHash(const MapInfo* pMapInfo, const EnemySet* pEnemies,
+								LinkedList* pMirrorList, int isMirrorFire);
+void destroyZobristHash(ZobristHash* pZobrist);
+void resetZobristHash(ZobristHash* pZobrist, const EnemySet* pEnemies, const GameObj* pPlayer);
+
+/* Zobrist Hash Update Methods */
+void moveZobristPlayer(ZobristHash* pZobrist, const GameObj* pOld, const GameObj* pNew);
+void killZobristEnemy(ZobristHash* pZobrist, const EnemySet* pEnemies, int enemyIdx);
+
+#endif